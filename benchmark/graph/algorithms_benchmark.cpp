@@ -0,0 +1,77 @@
+#include "gdwg/algorithms.hpp"
+
+#include "generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace {
+	using gdwg::bench::power_law_degree;
+	using gdwg::bench::uniform_degree;
+
+	// Weights are drawn from [0, 100), so this is about the largest weight over the average degree.
+	constexpr auto delta = 12;
+
+	auto node_count(benchmark::State const& state) -> std::size_t {
+		return static_cast<std::size_t>(state.range(0));
+	}
+
+	template<typename Degree>
+	auto dijkstra(benchmark::State& state) -> void {
+		auto const& g = gdwg::freeze(gdwg::bench::cached_graph<int, int, Degree>(node_count(state)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::dijkstra(g, 0));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	// The second argument is the number of threads.
+	template<typename Degree>
+	auto delta_stepping(benchmark::State& state) -> void {
+		auto const& g = gdwg::freeze(gdwg::bench::cached_graph<int, int, Degree>(node_count(state)));
+		auto const threads = static_cast<std::size_t>(state.range(1));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::delta_stepping(g, 0, delta, threads));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	// The second argument is the number of threads. Reports traversed edges per second (TEPS).
+	template<typename Degree>
+	auto bfs(benchmark::State& state) -> void {
+		auto const& g = gdwg::freeze(gdwg::bench::cached_graph<int, int, Degree>(node_count(state)));
+		auto const threads = static_cast<std::size_t>(state.range(1));
+		auto edges = std::size_t{0};
+		auto seconds = 0.0;
+		for (auto _ : state) {
+			auto const res = gdwg::bfs(g, 0, threads);
+			edges += res.edges_traversed;
+			seconds += res.elapsed.count();
+		}
+		state.counters["teps"] = benchmark::Counter(static_cast<double>(edges) / seconds);
+	}
+
+	auto graph_sizes(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+	}
+
+	auto graph_sizes_and_threads(benchmark::internal::Benchmark* b) -> void {
+		auto const max_threads = static_cast<std::int64_t>(std::thread::hardware_concurrency());
+		for (auto nodes = std::int64_t{1} << 12; nodes <= std::int64_t{1} << 18; nodes *= 8) {
+			for (auto threads = std::int64_t{1}; threads <= max_threads; threads *= 2) {
+				b->Args({nodes, threads});
+			}
+		}
+		b->UseRealTime();
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(dijkstra, uniform_degree)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(dijkstra, power_law_degree)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(delta_stepping, uniform_degree)->Apply(graph_sizes_and_threads);
+BENCHMARK_TEMPLATE(delta_stepping, power_law_degree)->Apply(graph_sizes_and_threads);
+BENCHMARK_TEMPLATE(bfs, uniform_degree)->Apply(graph_sizes_and_threads);
+BENCHMARK_TEMPLATE(bfs, power_law_degree)->Apply(graph_sizes_and_threads);
@@ -0,0 +1,120 @@
+#include "gdwg/concurrent_graph.hpp"
+
+#include "generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+	using gdwg::bench::uniform_degree;
+
+	constexpr auto nodes = std::size_t{1} << 14;
+
+	// Number of lookups timed per iteration by each reader thread.
+	constexpr auto lookups = std::size_t{1024};
+
+	auto shared_graph() -> gdwg::graph<int, int> const& {
+		return gdwg::bench::cached_graph<int, int, uniform_degree>(nodes);
+	}
+
+	auto shared_edges() -> std::vector<gdwg::graph<int, int>::value_type> const& {
+		static auto const edges = std::vector(shared_graph().begin(), shared_graph().end());
+		return edges;
+	}
+
+	// Looks up lookups edges, starting from a different place on each thread.
+	template<typename Graph>
+	auto look_up_edges(Graph const& g, std::size_t thread) -> void {
+		auto const& edges = shared_edges();
+		for (auto i = std::size_t{0}; i < lookups; ++i) {
+			auto const& [from, to, weight] = edges[(thread * 7919 + i * 31) % edges.size()];
+			benchmark::DoNotOptimize(g.find(from, to, weight));
+		}
+	}
+
+	// Whether thread 0 publishes an update on every iteration instead of reading.
+	enum class writer { none, one };
+
+	// Every thread shares one graph behind a mutex.
+	template<writer Writer>
+	auto mutex_readers(benchmark::State& state) -> void {
+		static auto g = shared_graph();
+		static auto mutex = std::mutex{};
+		auto const thread = static_cast<std::size_t>(state.thread_index());
+		auto const writes = Writer == writer::one && thread == 0;
+		for (auto _ : state) {
+			if (writes) {
+				auto const lock = std::scoped_lock(mutex);
+				// a copy stands in for the batch a writer would apply, to match snapshot_readers
+				auto next = g;
+				next.insert_edge(0, 1, -1);
+				g = std::move(next);
+				continue;
+			}
+			auto const lock = std::scoped_lock(mutex);
+			look_up_edges(g, thread);
+		}
+		if (!writes) {
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lookups));
+		}
+	}
+
+	// Every thread reads through its own concurrent_graph reader.
+	template<writer Writer>
+	auto snapshot_readers(benchmark::State& state) -> void {
+		static auto g = gdwg::concurrent_graph<int, int>(shared_graph());
+		auto const thread = static_cast<std::size_t>(state.thread_index());
+		auto const writes = Writer == writer::one && thread == 0;
+		auto r = gdwg::concurrent_graph<int, int>::reader(g);
+		for (auto _ : state) {
+			if (writes) {
+				g.update([](gdwg::graph<int, int>& next) { next.insert_edge(0, 1, -1); });
+				continue;
+			}
+			look_up_edges(r.snapshot(), thread);
+		}
+		if (!writes) {
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lookups));
+		}
+	}
+
+	// Every thread queries through concurrent_graph's accessors, which keep a reader per thread.
+	template<writer Writer>
+	auto accessor_readers(benchmark::State& state) -> void {
+		static auto g = gdwg::concurrent_graph<int, int>(shared_graph());
+		auto const thread = static_cast<std::size_t>(state.thread_index());
+		auto const writes = Writer == writer::one && thread == 0;
+		auto const& edges = shared_edges();
+		for (auto _ : state) {
+			if (writes) {
+				g.update([](gdwg::graph<int, int>& next) { next.insert_edge(0, 1, -1); });
+				continue;
+			}
+			for (auto i = std::size_t{0}; i < lookups; ++i) {
+				auto const& [from, to, weight] = edges[(thread * 7919 + i * 31) % edges.size()];
+				benchmark::DoNotOptimize(g.is_connected(from, to));
+			}
+		}
+		if (!writes) {
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lookups));
+		}
+	}
+
+	auto reader_threads(benchmark::internal::Benchmark* b) -> void {
+		auto const max_threads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+		b->ThreadRange(1, max_threads)->UseRealTime();
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(mutex_readers, writer::none)->Apply(reader_threads);
+BENCHMARK_TEMPLATE(snapshot_readers, writer::none)->Apply(reader_threads);
+BENCHMARK_TEMPLATE(accessor_readers, writer::none)->Apply(reader_threads);
+BENCHMARK_TEMPLATE(mutex_readers, writer::one)->Apply(reader_threads);
+BENCHMARK_TEMPLATE(snapshot_readers, writer::one)->Apply(reader_threads);
+BENCHMARK_TEMPLATE(accessor_readers, writer::one)->Apply(reader_threads);
@@ -0,0 +1,62 @@
+#include "gdwg/csr_file.hpp"
+
+#include "generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace {
+	using gdwg::bench::uniform_degree;
+
+	auto node_count(benchmark::State const& state) -> std::size_t {
+		return static_cast<std::size_t>(state.range(0));
+	}
+
+	auto file_path(benchmark::State const& state) -> std::filesystem::path {
+		return std::filesystem::temp_directory_path()
+		       / ("gdwg_csr_file_benchmark_" + std::to_string(state.range(0)));
+	}
+
+	auto write_binary(benchmark::State& state) -> void {
+		auto const& g =
+		   gdwg::freeze(gdwg::bench::cached_graph<int, int, uniform_degree>(node_count(state)));
+		auto const path = file_path(state);
+		for (auto _ : state) {
+			gdwg::write_binary(g, path);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+		std::filesystem::remove(path);
+	}
+
+	// Maps a file and answers one query, which is all it takes before a loaded graph is usable.
+	auto map_binary(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<int, int, uniform_degree>(node_count(state));
+		auto const path = file_path(state);
+		gdwg::write_binary(g, path);
+		for (auto _ : state) {
+			auto const view = gdwg::map_binary<int, int>(path);
+			benchmark::DoNotOptimize(view.connections(0));
+		}
+		std::filesystem::remove(path);
+	}
+
+	// The baseline map_binary() avoids: rebuilding the snapshot from a graph already in memory.
+	auto freeze(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<int, int, uniform_degree>(node_count(state));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::freeze(g).connections(0));
+		}
+	}
+
+	auto graph_sizes(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+	}
+} // namespace
+
+BENCHMARK(write_binary)->Apply(graph_sizes);
+BENCHMARK(map_binary)->Apply(graph_sizes);
+BENCHMARK(freeze)->Apply(graph_sizes);
@@ -0,0 +1,83 @@
+#include "gdwg/dense_graph.hpp"
+
+#include "generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Each benchmark runs on graph and on dense_graph, built from the same edges, so the two can be
+// compared directly.
+namespace {
+	using gdwg::bench::uniform_degree;
+
+	using node = std::uint32_t;
+	using weight = float;
+
+	auto node_count(benchmark::State const& state) -> std::size_t {
+		return static_cast<std::size_t>(state.range(0));
+	}
+
+	template<typename G>
+	auto make_graph(std::size_t nodes) -> G {
+		auto const values = gdwg::bench::make_nodes<node>(nodes);
+		auto const edges = gdwg::bench::make_edges<node, weight, uniform_degree>(nodes);
+		auto g = G(values.begin(), values.end());
+		g.insert_edges(edges.begin(), edges.end());
+		return g;
+	}
+
+	// Inserts every edge one at a time into a graph that already holds the nodes.
+	template<typename G>
+	auto insert_edge(benchmark::State& state) -> void {
+		auto const values = gdwg::bench::make_nodes<node>(node_count(state));
+		auto const edges = gdwg::bench::make_edges<node, weight, uniform_degree>(node_count(state));
+		for (auto _ : state) {
+			auto g = G(values.begin(), values.end());
+			for (auto const& [from, to, w] : edges) {
+				g.insert_edge(from, to, w);
+			}
+			benchmark::DoNotOptimize(g.edge_count());
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	// Looks up every stored edge.
+	template<typename G>
+	auto find(benchmark::State& state) -> void {
+		auto const g = make_graph<G>(node_count(state));
+		auto const edges = std::vector<typename G::value_type>(g.begin(), g.end());
+		for (auto _ : state) {
+			for (auto const& [from, to, w] : edges) {
+				benchmark::DoNotOptimize(g.find(from, to, w));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	template<typename G>
+	auto iteration(benchmark::State& state) -> void {
+		auto const g = make_graph<G>(node_count(state));
+		for (auto _ : state) {
+			auto total = weight{0};
+			for (auto const& [from, to, w] : g) {
+				total += w;
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	auto graph_sizes(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(insert_edge, gdwg::graph<node, weight>)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(insert_edge, gdwg::dense_graph<node, weight>)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(find, gdwg::graph<node, weight>)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(find, gdwg::dense_graph<node, weight>)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(iteration, gdwg::graph<node, weight>)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(iteration, gdwg::dense_graph<node, weight>)->Apply(graph_sizes);
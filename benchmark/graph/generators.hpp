@@ -0,0 +1,126 @@
+#ifndef GDWG_BENCHMARK_GRAPH_GENERATORS_HPP
+#define GDWG_BENCHMARK_GRAPH_GENERATORS_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Reproducible inputs shared by the graph benchmarks.
+namespace gdwg::bench {
+	// Average number of outgoing edges per node in generated graphs.
+	inline constexpr auto average_degree = std::size_t{8};
+
+	// Every node is equally likely to be the source of an edge.
+	struct uniform_degree {
+		[[nodiscard]] static auto sources(std::size_t nodes) {
+			return std::uniform_int_distribution<std::size_t>(0, nodes - 1);
+		}
+	};
+
+	// The i-th node is the source of an edge with probability proportional to 1 / (i + 1), so a few
+	// hub nodes hold most of the edges.
+	struct power_law_degree {
+		[[nodiscard]] static auto sources(std::size_t nodes) {
+			auto weights = std::vector<double>(nodes);
+			for (auto i = std::size_t{0}; i < nodes; ++i) {
+				weights[i] = 1.0 / static_cast<double>(i + 1);
+			}
+			return std::discrete_distribution<std::size_t>(weights.begin(), weights.end());
+		}
+	};
+
+	// A node id that counts every comparison made between ids, to show how many tree and edge set
+	// searches an operation does. Not thread safe.
+	struct counted_node {
+		std::size_t id = 0;
+
+		inline static auto comparisons = std::size_t{0};
+
+		counted_node() = default;
+
+		explicit counted_node(std::size_t i)
+		: id{i} {}
+
+		friend auto operator<(counted_node const& lhs, counted_node const& rhs) -> bool {
+			++comparisons;
+			return lhs.id < rhs.id;
+		}
+
+		friend auto operator==(counted_node const& lhs, counted_node const& rhs) -> bool {
+			++comparisons;
+			return lhs.id == rhs.id;
+		}
+	};
+
+	// Returns the node with id i. Strings are long enough to live on the heap, as ids in real
+	// topologies do.
+	template<typename N>
+	[[nodiscard]] auto make_node(std::size_t i) -> N {
+		if constexpr (std::is_same_v<N, std::string>) {
+			auto id = std::to_string(i);
+			return "node-" + std::string(20 - id.size(), '0') + id;
+		}
+		else {
+			return static_cast<N>(i);
+		}
+	}
+
+	template<typename N>
+	[[nodiscard]] auto make_nodes(std::size_t nodes) -> std::vector<N> {
+		auto res = std::vector<N>{};
+		res.reserve(nodes);
+		for (auto i = std::size_t{0}; i < nodes; ++i) {
+			res.push_back(make_node<N>(i));
+		}
+		return res;
+	}
+
+	// Returns nodes * average_degree edges in random order, with sources drawn from Degree and
+	// destinations and weights drawn uniformly.
+	template<typename N, typename E, typename Degree>
+	[[nodiscard]] auto make_edges(std::size_t nodes)
+	   -> std::vector<typename graph<N, E>::value_type> {
+		auto engine = std::mt19937_64{6771};
+		auto sources = Degree::sources(nodes);
+		auto destinations = std::uniform_int_distribution<std::size_t>(0, nodes - 1);
+		auto weights = std::uniform_int_distribution<int>(0, 99);
+
+		auto res = std::vector<typename graph<N, E>::value_type>{};
+		res.reserve(nodes * average_degree);
+		for (auto i = std::size_t{0}; i < nodes * average_degree; ++i) {
+			res.push_back({make_node<N>(sources(engine)),
+			               make_node<N>(destinations(engine)),
+			               static_cast<E>(weights(engine))});
+		}
+		return res;
+	}
+
+	template<typename N, typename E, typename Degree>
+	[[nodiscard]] auto make_graph(std::size_t nodes) -> graph<N, E> {
+		auto const node_values = make_nodes<N>(nodes);
+		auto const edges = make_edges<N, E, Degree>(nodes);
+		auto g = graph<N, E>(node_values.begin(), node_values.end());
+		g.insert_edges(edges.begin(), edges.end());
+		return g;
+	}
+
+	// Returns a graph built by make_graph, building it only the first time it is asked for so that
+	// benchmarks sharing an input don't pay for it again.
+	template<typename N, typename E, typename Degree>
+	[[nodiscard]] auto cached_graph(std::size_t nodes) -> graph<N, E> const& {
+		static auto cache = std::map<std::size_t, graph<N, E>>{};
+		auto iter = cache.find(nodes);
+		if (iter == cache.end()) {
+			iter = cache.emplace(nodes, make_graph<N, E, Degree>(nodes)).first;
+		}
+		return iter->second;
+	}
+} // namespace gdwg::bench
+
+#endif // GDWG_BENCHMARK_GRAPH_GENERATORS_HPP
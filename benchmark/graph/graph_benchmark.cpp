@@ -0,0 +1,587 @@
+#include "gdwg/graph.hpp"
+
+#include "generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	using gdwg::bench::power_law_degree;
+	using gdwg::bench::uniform_degree;
+
+	// Number of operations timed per iteration by the benchmarks that sample nodes or edges.
+	constexpr auto samples = std::size_t{4096};
+
+	// Number of nodes erased or merged per iteration. Kept small because the graph has to be copied
+	// (untimed) before every iteration.
+	constexpr auto destructive_samples = std::size_t{64};
+
+	auto graph_sizes(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+	}
+
+	auto node_count(benchmark::State const& state) -> std::size_t {
+		return static_cast<std::size_t>(state.range(0));
+	}
+
+	// Returns count node values picked uniformly from a graph with nodes nodes.
+	template<typename N>
+	auto sample_nodes(std::size_t nodes, std::size_t count) -> std::vector<N> {
+		auto engine = std::mt19937_64{count};
+		auto ids = std::uniform_int_distribution<std::size_t>(0, nodes - 1);
+		auto res = std::vector<N>{};
+		res.reserve(count);
+		for (auto i = std::size_t{0}; i < count; ++i) {
+			res.push_back(gdwg::bench::make_node<N>(ids(engine)));
+		}
+		return res;
+	}
+
+	// Returns count edges picked uniformly from g.
+	template<typename N>
+	auto sample_edges(gdwg::graph<N, int> const& g, std::size_t count)
+	   -> std::vector<typename gdwg::graph<N, int>::value_type> {
+		auto const all = std::vector<typename gdwg::graph<N, int>::value_type>(g.begin(), g.end());
+		auto engine = std::mt19937_64{count};
+		auto indices = std::uniform_int_distribution<std::size_t>(0, all.size() - 1);
+		auto res = std::vector<typename gdwg::graph<N, int>::value_type>{};
+		res.reserve(count);
+		for (auto i = std::size_t{0}; i < count; ++i) {
+			res.push_back(all[indices(engine)]);
+		}
+		return res;
+	}
+
+	// --------------------------------------------
+	// Modifiers
+	// --------------------------------------------
+
+	template<typename N>
+	auto insert_node(benchmark::State& state) -> void {
+		auto values = gdwg::bench::make_nodes<N>(node_count(state));
+		std::shuffle(values.begin(), values.end(), std::mt19937_64{values.size()});
+		for (auto _ : state) {
+			auto g = gdwg::graph<N, int>{};
+			for (auto const& value : values) {
+				g.insert_node(value);
+			}
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto insert_edge(benchmark::State& state) -> void {
+		auto const nodes = gdwg::bench::make_nodes<N>(node_count(state));
+		auto const edges = gdwg::bench::make_edges<N, int, Degree>(node_count(state));
+		for (auto _ : state) {
+			auto g = gdwg::graph<N, int>(nodes.begin(), nodes.end());
+			for (auto const& [from, to, weight] : edges) {
+				g.insert_edge(from, to, weight);
+			}
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto insert_edges(benchmark::State& state) -> void {
+		auto const nodes = gdwg::bench::make_nodes<N>(node_count(state));
+		auto const edges = gdwg::bench::make_edges<N, int, Degree>(node_count(state));
+		for (auto _ : state) {
+			auto g = gdwg::graph<N, int>(nodes.begin(), nodes.end());
+			g.insert_edges(edges.begin(), edges.end());
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	// Same as insert_edges, but with the whole graph allocated from an arena that is released in one
+	// go at the end of each iteration.
+	template<typename N, typename Degree>
+	auto insert_edges_arena(benchmark::State& state) -> void {
+		auto const nodes = gdwg::bench::make_nodes<N>(node_count(state));
+		auto const edges = gdwg::bench::make_edges<N, int, Degree>(node_count(state));
+		for (auto _ : state) {
+			auto arena = std::pmr::monotonic_buffer_resource{};
+			auto g = gdwg::graph<N, int>(nodes.begin(), nodes.end(), &arena);
+			g.insert_edges(edges.begin(), edges.end());
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto erase_node(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto const victims = sample_nodes<N>(node_count(state), destructive_samples);
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto copy = g;
+			state.ResumeTiming();
+			for (auto const& victim : victims) {
+				benchmark::DoNotOptimize(copy.erase_node(victim));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(victims.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto merge_replace_node(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto ids = std::vector<std::size_t>(node_count(state));
+		std::iota(ids.begin(), ids.end(), std::size_t{0});
+		std::shuffle(ids.begin(), ids.end(), std::mt19937_64{ids.size()});
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto copy = g;
+			state.ResumeTiming();
+			for (auto i = std::size_t{0}; i < destructive_samples; ++i) {
+				copy.merge_replace_node(gdwg::bench::make_node<N>(ids[2 * i]),
+				                        gdwg::bench::make_node<N>(ids[2 * i + 1]));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(destructive_samples));
+	}
+
+	// --------------------------------------------
+	// Accessors
+	// --------------------------------------------
+
+	template<typename N, typename Degree>
+	auto find(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto const edges = sample_edges(g, samples);
+		for (auto _ : state) {
+			for (auto const& [from, to, weight] : edges) {
+				benchmark::DoNotOptimize(g.find(from, to, weight));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto connections(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto const nodes = sample_nodes<N>(node_count(state), samples);
+		for (auto _ : state) {
+			for (auto const& node : nodes) {
+				benchmark::DoNotOptimize(g.connections(node));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto weights(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto const edges = sample_edges(g, samples);
+		for (auto _ : state) {
+			for (auto const& edge : edges) {
+				benchmark::DoNotOptimize(g.weights(edge.from, edge.to));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto neighbours(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto const nodes = sample_nodes<N>(node_count(state), samples);
+		for (auto _ : state) {
+			for (auto const& node : nodes) {
+				for (auto const& neighbour : g.neighbours(node)) {
+					benchmark::DoNotOptimize(neighbour);
+				}
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto weights_view(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto const edges = sample_edges(g, samples);
+		for (auto _ : state) {
+			for (auto const& edge : edges) {
+				for (auto const weight : g.weights_view(edge.from, edge.to)) {
+					benchmark::DoNotOptimize(weight);
+				}
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto iteration(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto edges = std::int64_t{0};
+		for (auto _ : state) {
+			auto sum = 0;
+			for (auto const& [from, to, weight] : g) {
+				sum += weight;
+				++edges;
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(edges);
+	}
+
+	template<typename N, typename Degree>
+	auto copy_construct(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		for (auto _ : state) {
+			auto copy = gdwg::graph<N, int>(g);
+			benchmark::DoNotOptimize(copy);
+		}
+	}
+
+	template<typename N, typename Degree>
+	auto equality(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto const copy = g;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g == copy);
+		}
+	}
+
+	// --------------------------------------------
+	// Large graphs
+	// --------------------------------------------
+	// Graphs of ten million nodes and no other edges, far larger than the caches, so every node
+	// lookup pays for the memory it touches. They are too large to cache between benchmarks.
+
+	constexpr auto large_graph_size = std::size_t{10'000'000};
+
+	template<typename N>
+	auto make_large_graph() -> gdwg::graph<N, int> {
+		auto const values = gdwg::bench::make_nodes<N>(large_graph_size);
+		return gdwg::graph<N, int>(values.begin(), values.end());
+	}
+
+	template<typename N>
+	auto large_is_node(benchmark::State& state) -> void {
+		auto const g = make_large_graph<N>();
+		auto const nodes = sample_nodes<N>(large_graph_size, samples);
+		for (auto _ : state) {
+			for (auto const& node : nodes) {
+				benchmark::DoNotOptimize(g.is_node(node));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+	}
+
+	// Every iteration after the first finds the edges already stored, so this mostly times the
+	// two node lookups each call makes.
+	template<typename N>
+	auto large_insert_edge(benchmark::State& state) -> void {
+		auto g = make_large_graph<N>();
+		auto const srcs = sample_nodes<N>(large_graph_size, samples);
+		auto const dsts = sample_nodes<N>(large_graph_size, samples + 1);
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < samples; ++i) {
+				benchmark::DoNotOptimize(g.insert_edge(srcs[i], dsts[i], 1));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(samples));
+	}
+
+	// --------------------------------------------
+	// Multigraphs
+	// --------------------------------------------
+	// Every node has state.range(0) parallel edges to every node, so the edges far outnumber the
+	// distinct destinations. The weights are even, so odd weights are never stored.
+
+	constexpr auto multigraph_nodes = 16;
+
+	auto parallel_edges(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(16)->Range(16, 4096);
+	}
+
+	auto make_multigraph(benchmark::State const& state) -> gdwg::graph<int, int> {
+		auto const parallel = static_cast<int>(state.range(0));
+		auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+		for (auto src = 0; src < multigraph_nodes; ++src) {
+			for (auto dst = 0; dst < multigraph_nodes; ++dst) {
+				for (auto weight = 0; weight < parallel; ++weight) {
+					edges.push_back({src, dst, 2 * weight});
+				}
+			}
+		}
+		return gdwg::graph<int, int>::from_edges(edges.begin(), edges.end());
+	}
+
+	auto multigraph_weights(benchmark::State& state) -> void {
+		auto const g = make_multigraph(state);
+		for (auto _ : state) {
+			for (auto src = 0; src < multigraph_nodes; ++src) {
+				for (auto dst = 0; dst < multigraph_nodes; ++dst) {
+					benchmark::DoNotOptimize(g.weights(src, dst));
+				}
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * multigraph_nodes * multigraph_nodes);
+	}
+
+	auto multigraph_weights_view(benchmark::State& state) -> void {
+		auto const g = make_multigraph(state);
+		for (auto _ : state) {
+			for (auto src = 0; src < multigraph_nodes; ++src) {
+				for (auto dst = 0; dst < multigraph_nodes; ++dst) {
+					auto const weights = g.weights_view(src, dst);
+					benchmark::DoNotOptimize(std::accumulate(weights.begin(), weights.end(), 0));
+				}
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * multigraph_nodes * multigraph_nodes);
+	}
+
+	auto multigraph_connections(benchmark::State& state) -> void {
+		auto const g = make_multigraph(state);
+		for (auto _ : state) {
+			for (auto src = 0; src < multigraph_nodes; ++src) {
+				benchmark::DoNotOptimize(g.connections(src));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * multigraph_nodes);
+	}
+
+	auto multigraph_is_connected(benchmark::State& state) -> void {
+		auto const g = make_multigraph(state);
+		for (auto _ : state) {
+			for (auto src = 0; src < multigraph_nodes; ++src) {
+				for (auto dst = 0; dst < multigraph_nodes; ++dst) {
+					benchmark::DoNotOptimize(g.is_connected(src, dst));
+				}
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * multigraph_nodes * multigraph_nodes);
+	}
+
+	// Erases a stored weight from the middle of a run, then puts it back.
+	auto multigraph_erase_edge(benchmark::State& state) -> void {
+		auto g = make_multigraph(state);
+		auto const weight = 2 * static_cast<int>(state.range(0) / 2);
+		for (auto _ : state) {
+			for (auto dst = 0; dst < multigraph_nodes; ++dst) {
+				benchmark::DoNotOptimize(g.erase_edge(0, dst, weight));
+				benchmark::DoNotOptimize(g.insert_edge(0, dst, weight));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * multigraph_nodes);
+	}
+
+	// --------------------------------------------
+	// Unweighted graphs
+	// --------------------------------------------
+
+	// Forwards to the default resource, counting the bytes allocated through it.
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		[[nodiscard]] auto bytes_allocated() const noexcept -> std::size_t {
+			return bytes_allocated_;
+		}
+
+	private:
+		std::size_t bytes_allocated_ = 0;
+
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			bytes_allocated_ += bytes;
+			return std::pmr::get_default_resource()->allocate(bytes, alignment);
+		}
+
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+		}
+
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override {
+			return this == &other;
+		}
+	};
+
+	// Walks a graph that only records which nodes are connected, with E as its weight type, and
+	// reports how many bytes the graph allocated per edge, nodes included.
+	template<typename E>
+	auto topology_iteration(benchmark::State& state) -> void {
+		auto const& weighted = gdwg::bench::cached_graph<int, int, uniform_degree>(node_count(state));
+		auto batch = std::vector<typename gdwg::graph<int, E>::value_type>{};
+		for (auto const& [from, to, _] : weighted) {
+			batch.push_back({from, to, E{}});
+		}
+		auto const nodes = weighted.nodes();
+		auto resource = counting_resource{};
+		auto g = gdwg::graph<int, E>(nodes.begin(), nodes.end(), &resource);
+		g.insert_edges(batch.begin(), batch.end());
+		auto const bytes = resource.bytes_allocated();
+
+		auto edges = std::int64_t{0};
+		for (auto _ : state) {
+			auto sum = 0;
+			for (auto const& [from, to, weight] : g) {
+				sum += to;
+				++edges;
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(edges);
+		state.counters["bytes_per_edge"] =
+		   static_cast<double>(bytes) / static_cast<double>(g.edge_count());
+	}
+
+	// --------------------------------------------
+	// Comparisons
+	// --------------------------------------------
+	// Each operation below leaves the graph as it found it, and reports the node comparisons it
+	// makes, which is a proxy for the tree and edge set searches it does.
+
+	using counted_graph = gdwg::graph<gdwg::bench::counted_node, int>;
+	using counted_edge = counted_graph::value_type;
+
+	struct is_connected_op {
+		static auto apply(counted_graph& g, counted_edge const& edge) -> void {
+			benchmark::DoNotOptimize(g.is_connected(edge.from, edge.to));
+		}
+	};
+
+	struct weights_op {
+		static auto apply(counted_graph& g, counted_edge const& edge) -> void {
+			benchmark::DoNotOptimize(g.weights(edge.from, edge.to));
+		}
+	};
+
+	struct connections_op {
+		static auto apply(counted_graph& g, counted_edge const& edge) -> void {
+			benchmark::DoNotOptimize(g.connections(edge.from));
+		}
+	};
+
+	// edge is already stored, so nothing is inserted
+	struct insert_edge_op {
+		static auto apply(counted_graph& g, counted_edge const& edge) -> void {
+			benchmark::DoNotOptimize(g.insert_edge(edge.from, edge.to, edge.weight));
+		}
+	};
+
+	struct erase_edge_op {
+		static auto apply(counted_graph& g, counted_edge const& edge) -> void {
+			benchmark::DoNotOptimize(g.erase_edge(edge.from, edge.to, edge.weight));
+			benchmark::DoNotOptimize(g.insert_edge(edge.from, edge.to, edge.weight));
+		}
+	};
+
+	struct replace_node_op {
+		static auto apply(counted_graph& g, counted_edge const& edge) -> void {
+			auto const fresh = gdwg::bench::counted_node(edge.from.id + g.node_count());
+			benchmark::DoNotOptimize(g.replace_node(edge.from, fresh));
+			benchmark::DoNotOptimize(g.replace_node(fresh, edge.from));
+		}
+	};
+
+	template<typename Op>
+	auto comparisons(benchmark::State& state) -> void {
+		auto g = gdwg::bench::make_graph<gdwg::bench::counted_node, int, uniform_degree>(
+		   node_count(state));
+		auto const edges = sample_edges(g, samples);
+		auto const before = gdwg::bench::counted_node::comparisons;
+		for (auto _ : state) {
+			for (auto const& edge : edges) {
+				Op::apply(g, edge);
+			}
+		}
+		auto const made = gdwg::bench::counted_node::comparisons - before;
+		state.counters["comparisons"] =
+		   benchmark::Counter(static_cast<double>(made) / static_cast<double>(edges.size()),
+		                      benchmark::Counter::kAvgIterations);
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	// Looks edges of a std::string graph up by the C strings a client would pass in, converted to
+	// Key at each call. Node names are longer than the small string buffer, so a std::string key
+	// allocates twice per call.
+	template<typename Key>
+	auto is_connected_by_key(benchmark::State& state) -> void {
+		auto const& g =
+		   gdwg::bench::cached_graph<std::string, int, uniform_degree>(node_count(state));
+		auto const edges = sample_edges(g, samples);
+		for (auto _ : state) {
+			for (auto const& edge : edges) {
+				benchmark::DoNotOptimize(g.is_connected(Key(edge.from.c_str()), Key(edge.to.c_str())));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+
+	template<typename N, typename Degree>
+	auto print(benchmark::State& state) -> void {
+		auto const& g = gdwg::bench::cached_graph<N, int, Degree>(node_count(state));
+		auto os = std::ostringstream{};
+		auto bytes = std::int64_t{0};
+		for (auto _ : state) {
+			os.str("");
+			os << g;
+			bytes += static_cast<std::int64_t>(os.tellp());
+		}
+		state.SetBytesProcessed(bytes);
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(insert_node, int)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(insert_node, std::string)->Apply(graph_sizes);
+
+// Registers name for every combination of node type and degree distribution.
+#define GDWG_GRAPH_BENCHMARK(name)                                                                 \
+	BENCHMARK_TEMPLATE(name, int, uniform_degree)->Apply(graph_sizes);                              \
+	BENCHMARK_TEMPLATE(name, int, power_law_degree)->Apply(graph_sizes);                            \
+	BENCHMARK_TEMPLATE(name, std::string, uniform_degree)->Apply(graph_sizes);                      \
+	BENCHMARK_TEMPLATE(name, std::string, power_law_degree)->Apply(graph_sizes)
+
+GDWG_GRAPH_BENCHMARK(insert_edge);
+GDWG_GRAPH_BENCHMARK(insert_edges);
+GDWG_GRAPH_BENCHMARK(insert_edges_arena);
+GDWG_GRAPH_BENCHMARK(erase_node);
+GDWG_GRAPH_BENCHMARK(merge_replace_node);
+GDWG_GRAPH_BENCHMARK(find);
+GDWG_GRAPH_BENCHMARK(connections);
+GDWG_GRAPH_BENCHMARK(weights);
+GDWG_GRAPH_BENCHMARK(neighbours);
+GDWG_GRAPH_BENCHMARK(weights_view);
+GDWG_GRAPH_BENCHMARK(iteration);
+GDWG_GRAPH_BENCHMARK(copy_construct);
+GDWG_GRAPH_BENCHMARK(equality);
+GDWG_GRAPH_BENCHMARK(print);
+
+BENCHMARK_TEMPLATE(large_is_node, int)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(large_is_node, std::string)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(large_insert_edge, int)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(large_insert_edge, std::string)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(multigraph_weights)->Apply(parallel_edges);
+BENCHMARK(multigraph_weights_view)->Apply(parallel_edges);
+BENCHMARK(multigraph_connections)->Apply(parallel_edges);
+BENCHMARK(multigraph_is_connected)->Apply(parallel_edges);
+BENCHMARK(multigraph_erase_edge)->Apply(parallel_edges);
+
+BENCHMARK_TEMPLATE(topology_iteration, bool)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(topology_iteration, gdwg::unweighted)->Apply(graph_sizes);
+
+BENCHMARK_TEMPLATE(is_connected_by_key, std::string)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(is_connected_by_key, std::string_view)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(is_connected_by_key, char const*)->Apply(graph_sizes);
+
+BENCHMARK_TEMPLATE(comparisons, is_connected_op)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(comparisons, weights_op)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(comparisons, connections_op)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(comparisons, insert_edge_op)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(comparisons, erase_edge_op)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(comparisons, replace_node_op)->Apply(graph_sizes);
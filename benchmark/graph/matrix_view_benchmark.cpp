@@ -0,0 +1,211 @@
+#include "gdwg/matrix_view.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <new>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Counts every byte allocated by the program, so that the footprint of a graph can be measured
+// whichever allocator its containers use.
+namespace {
+	auto allocated_bytes = std::size_t{0};
+} // namespace
+
+auto operator new(std::size_t bytes) -> void* {
+	allocated_bytes += bytes;
+	if (auto* p = std::malloc(bytes)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+auto operator delete(void* p) noexcept -> void {
+	std::free(p);
+}
+
+auto operator delete(void* p, std::size_t) noexcept -> void {
+	std::free(p);
+}
+
+auto operator new(std::size_t bytes, std::align_val_t alignment) -> void* {
+	allocated_bytes += bytes;
+	auto const align = static_cast<std::size_t>(alignment);
+	if (auto* p = std::aligned_alloc(align, (bytes + align - 1) / align * align)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+auto operator delete(void* p, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+
+auto operator delete(void* p, std::size_t, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+
+// Each benchmark runs on graph and on matrix_view, holding the same nearly complete graph, so the
+// two can be compared directly.
+namespace {
+	using node = int;
+	using weight = int;
+	using graph = gdwg::graph<node, weight>;
+	using matrix = gdwg::matrix_view<node, weight>;
+
+	// the chance that any given ordered pair of nodes is connected
+	constexpr auto density = 0.9;
+
+	auto node_count(benchmark::State const& state) -> std::size_t {
+		return static_cast<std::size_t>(state.range(0));
+	}
+
+	// Returns a graph over nodes 0, ..., nodes - 1, built once per size.
+	auto dense_graph(std::size_t nodes) -> graph const& {
+		static auto cache = std::map<std::size_t, graph>{};
+		auto iter = cache.find(nodes);
+		if (iter != cache.end()) {
+			return iter->second;
+		}
+
+		auto engine = std::mt19937{42};
+		auto connected = std::bernoulli_distribution(density);
+		auto batch = std::vector<graph::value_type>{};
+		for (auto src = node{0}; src < static_cast<node>(nodes); ++src) {
+			for (auto dst = node{0}; dst < static_cast<node>(nodes); ++dst) {
+				if (connected(engine)) {
+					batch.push_back({src, dst, src ^ dst});
+				}
+			}
+		}
+		auto values = std::vector<node>(nodes);
+		std::iota(values.begin(), values.end(), node{0});
+		auto g = graph(values.begin(), values.end());
+		g.insert_edges(batch.begin(), batch.end());
+		return cache.emplace(nodes, std::move(g)).first->second;
+	}
+
+	template<typename G>
+	auto make(std::size_t nodes) -> G {
+		if constexpr (std::is_same_v<G, matrix>) {
+			return matrix(dense_graph(nodes));
+		}
+		else {
+			return dense_graph(nodes);
+		}
+	}
+
+	auto random_pairs(std::size_t nodes) -> std::vector<std::pair<node, node>> {
+		auto engine = std::mt19937{7};
+		auto value = std::uniform_int_distribution<node>(0, static_cast<node>(nodes) - 1);
+		auto pairs = std::vector<std::pair<node, node>>(1 << 12);
+		for (auto& [a, b] : pairs) {
+			a = value(engine);
+			b = value(engine);
+		}
+		return pairs;
+	}
+
+	auto common_connections(graph const& g, node a, node b) -> std::size_t {
+		auto const a_out = g.connections(a);
+		auto const b_out = g.connections(b);
+		auto common = std::vector<node>{};
+		std::ranges::set_intersection(a_out, b_out, std::back_inserter(common));
+		return common.size();
+	}
+
+	auto common_connections(matrix const& g, node a, node b) -> std::size_t {
+		return g.common_connections(a, b);
+	}
+
+	template<typename G>
+	auto is_connected(benchmark::State& state) -> void {
+		auto const g = make<G>(node_count(state));
+		auto const pairs = random_pairs(node_count(state));
+		for (auto _ : state) {
+			for (auto const& [a, b] : pairs) {
+				benchmark::DoNotOptimize(g.is_connected(a, b));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+	}
+
+	// Tests the same pairs as is_connected, by index rather than by value. Nodes are 0 to n - 1,
+	// so each node's index is its value.
+	auto adjacent(benchmark::State& state) -> void {
+		auto const g = make<matrix>(node_count(state));
+		auto const pairs = random_pairs(node_count(state));
+		for (auto _ : state) {
+			for (auto const& [a, b] : pairs) {
+				benchmark::DoNotOptimize(
+				   g.adjacent(static_cast<std::size_t>(a), static_cast<std::size_t>(b)));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+	}
+
+	template<typename G>
+	auto degrees(benchmark::State& state) -> void {
+		auto const g = make<G>(node_count(state));
+		for (auto _ : state) {
+			for (auto value = node{0}; value < static_cast<node>(node_count(state)); ++value) {
+				benchmark::DoNotOptimize(g.out_degree(value) + g.in_degree(value));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename G>
+	auto intersection(benchmark::State& state) -> void {
+		auto const g = make<G>(node_count(state));
+		auto const pairs = random_pairs(node_count(state));
+		for (auto _ : state) {
+			for (auto const& [a, b] : pairs) {
+				benchmark::DoNotOptimize(common_connections(g, a, b));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+	}
+
+	// Builds the snapshot from a graph, and reports how many bytes it allocated per edge, nodes
+	// included, next to the bytes of the graph it was built from.
+	auto build(benchmark::State& state) -> void {
+		auto const before_graph = allocated_bytes;
+		auto const g = graph(dense_graph(node_count(state)));
+		auto const graph_bytes = allocated_bytes - before_graph;
+
+		auto bytes = std::size_t{0};
+		for (auto _ : state) {
+			auto const before = allocated_bytes;
+			auto const view = matrix(g);
+			bytes = allocated_bytes - before;
+			benchmark::DoNotOptimize(view.edge_count());
+		}
+		auto const edges = static_cast<double>(g.edge_count());
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+		state.counters["graph_bytes_per_edge"] = static_cast<double>(graph_bytes) / edges;
+		state.counters["matrix_bytes_per_edge"] = static_cast<double>(bytes) / edges;
+	}
+
+	auto graph_sizes(benchmark::internal::Benchmark* b) -> void {
+		b->Arg(256)->Arg(1024)->Arg(2048);
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(is_connected, graph)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(is_connected, matrix)->Apply(graph_sizes);
+BENCHMARK(adjacent)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(degrees, graph)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(degrees, matrix)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(intersection, graph)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(intersection, matrix)->Apply(graph_sizes);
+BENCHMARK(build)->Apply(graph_sizes)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,446 @@
+#ifndef GDWG_ALGORITHMS_HPP
+#define GDWG_ALGORITHMS_HPP
+
+#include "gdwg/csr_view.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// A min-heap where every element has four children instead of two. The tree is half as deep
+		// as a binary heap, and the children compared at each step sit next to each other in memory.
+		template<typename T>
+		class quaternary_heap {
+		public:
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return heap_.empty();
+			}
+
+			auto push(T value) -> void {
+				auto i = heap_.size();
+				heap_.push_back(std::move(value));
+				while (i > 0 && heap_[i] < heap_[parent(i)]) {
+					std::swap(heap_[i], heap_[parent(i)]);
+					i = parent(i);
+				}
+			}
+
+			// Removes and returns the smallest element.
+			auto pop() -> T {
+				auto top = std::move(heap_.front());
+				if (heap_.size() > 1) {
+					heap_.front() = std::move(heap_.back());
+				}
+				heap_.pop_back();
+
+				auto i = std::size_t{0};
+				while (first_child(i) < heap_.size()) {
+					auto const first = heap_.begin() + static_cast<std::ptrdiff_t>(first_child(i));
+					auto const last =
+					   first_child(i) + arity < heap_.size() ? first + arity : heap_.end();
+					auto const smallest = static_cast<std::size_t>(std::min_element(first, last)
+					                                               - heap_.begin());
+					if (!(heap_[smallest] < heap_[i])) {
+						break;
+					}
+					std::swap(heap_[i], heap_[smallest]);
+					i = smallest;
+				}
+				return top;
+			}
+
+		private:
+			static constexpr auto arity = std::size_t{4};
+
+			std::vector<T> heap_;
+
+			static auto parent(std::size_t i) -> std::size_t {
+				return (i - 1) / arity;
+			}
+
+			static auto first_child(std::size_t i) -> std::size_t {
+				return arity * i + 1;
+			}
+		};
+
+		template<typename N, typename E>
+		auto require_non_negative_weights(csr_view<N, E> const& g, char const* message) -> void {
+			for (auto i = std::size_t{0}; i < g.node_count(); ++i) {
+				auto const weights = g.edge_weights(i);
+				if (std::any_of(weights.begin(), weights.end(), [](E const& w) { return w < E{}; })) {
+					throw std::runtime_error(message);
+				}
+			}
+		}
+
+		// Lowers target to candidate if candidate is smaller.
+		// Returns: true if target was lowered, and false otherwise.
+		template<typename E>
+		auto atomic_min(std::atomic<E>& target, E candidate) -> bool {
+			auto current = target.load(std::memory_order_relaxed);
+			while (candidate < current) {
+				if (target.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Calls f(first, last, out) on consecutive slices of [0, count), running up to threads of
+		// them at once, where out is a vector that f may append to.
+		// Returns: Everything appended to out by every call.
+		template<typename F>
+		auto parallel_collect(std::size_t count, std::size_t threads, F const& f)
+		   -> std::vector<std::size_t> {
+			// below this many items per thread, starting a thread costs more than it saves
+			constexpr auto grain = std::size_t{256};
+			threads = std::clamp(count / grain, std::size_t{1}, std::max(threads, std::size_t{1}));
+
+			auto outs = std::vector<std::vector<std::size_t>>(threads);
+			auto const slice = [count, threads](std::size_t t) { return count * t / threads; };
+			{
+				auto workers = std::vector<std::jthread>{};
+				workers.reserve(threads - 1);
+				for (auto t = std::size_t{1}; t < threads; ++t) {
+					workers.emplace_back([&f, &outs, &slice, t] { f(slice(t), slice(t + 1), outs[t]); });
+				}
+				f(slice(0), slice(1), outs[0]);
+			}
+
+			for (auto t = std::size_t{1}; t < threads; ++t) {
+				outs[0].insert(outs[0].end(), outs[t].begin(), outs[t].end());
+			}
+			return std::move(outs[0]);
+		}
+
+		inline auto sort_unique(std::vector<std::size_t>& values) -> void {
+			std::sort(values.begin(), values.end());
+			values.erase(std::unique(values.begin(), values.end()), values.end());
+		}
+	} // namespace detail
+
+	// Finds the length of the shortest path from src to every node reachable from it, visiting
+	// nodes in order of distance using a 4-ary heap.
+	// Returns: Each reachable node paired with its distance from src, sorted in ascending order of
+	// node.
+	// Complexity: O((n + e) log (n)).
+	template<typename N, typename E>
+	[[nodiscard]] auto dijkstra(csr_view<N, E> const& g, N const& src)
+	   -> std::vector<std::pair<N, E>> {
+		auto const source = g.index_of(src);
+		if (source == csr_view<N, E>::npos) {
+			throw std::runtime_error("Cannot call gdwg::dijkstra if src doesn't exist in the graph");
+		}
+		detail::require_non_negative_weights(g,
+		                                     "Cannot call gdwg::dijkstra on a graph with negative "
+		                                     "edge weights");
+
+		auto dist = std::vector<E>(g.node_count());
+		auto reached = std::vector<char>(g.node_count());
+		auto heap = detail::quaternary_heap<std::pair<E, std::size_t>>{};
+		dist[source] = E{};
+		reached[source] = 1;
+		heap.push({E{}, source});
+		while (!heap.empty()) {
+			auto const [d, u] = heap.pop();
+			// u was pushed again with a shorter distance since this entry was added
+			if (dist[u] < d) {
+				continue;
+			}
+
+			auto const targets = g.targets(u);
+			auto const weights = g.edge_weights(u);
+			for (auto i = std::size_t{0}; i < targets.size(); ++i) {
+				auto const v = targets[i];
+				auto const candidate = d + weights[i];
+				if (!reached[v] || candidate < dist[v]) {
+					dist[v] = candidate;
+					reached[v] = 1;
+					heap.push({candidate, v});
+				}
+			}
+		}
+
+		auto res = std::vector<std::pair<N, E>>{};
+		for (auto i = std::size_t{0}; i < g.node_count(); ++i) {
+			if (reached[i]) {
+				res.emplace_back(g.node_at(i), dist[i]);
+			}
+		}
+		return res;
+	}
+
+	// Freezes g and runs dijkstra over the snapshot.
+	// Complexity: O(n + e) to freeze g, then as above.
+	template<typename N, typename E>
+	[[nodiscard]] auto dijkstra(graph<N, E> const& g, N const& src) -> std::vector<std::pair<N, E>> {
+		return dijkstra(freeze(g), src);
+	}
+
+	// Finds the same distances as dijkstra using up to threads threads. Nodes are grouped into
+	// buckets of width delta by tentative distance. The lowest bucket is emptied by relaxing its
+	// light edges (weight at most delta) in parallel until no node re-enters it. The heavy edges of
+	// every node that passed through it are then relaxed in parallel in one round. A delta around
+	// the largest weight divided by the average out-degree is usually a good start: smaller values
+	// approach dijkstra, and larger ones approach Bellman-Ford.
+	// Returns: Each reachable node paired with its distance from src, sorted in ascending order of
+	// node. Distances are sums of weights, so E must be arithmetic and not bool.
+	template<typename N, typename E>
+	requires(std::is_arithmetic_v<E> && !std::is_same_v<E, bool>)
+	[[nodiscard]] auto delta_stepping(csr_view<N, E> const& g,
+	                                  N const& src,
+	                                  E delta,
+	                                  std::size_t threads = std::thread::hardware_concurrency())
+	   -> std::vector<std::pair<N, E>> {
+		auto const source = g.index_of(src);
+		if (source == csr_view<N, E>::npos) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping if src doesn't exist in the "
+			                         "graph");
+		}
+		if (!(E{} < delta)) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping with a delta that isn't "
+			                         "positive");
+		}
+		detail::require_non_negative_weights(g,
+		                                     "Cannot call gdwg::delta_stepping on a graph with "
+		                                     "negative edge weights");
+
+		constexpr auto unreached = std::numeric_limits<E>::max();
+		auto dist = std::vector<std::atomic<E>>(g.node_count());
+		for (auto& d : dist) {
+			d.store(unreached, std::memory_order_relaxed);
+		}
+		dist[source].store(E{}, std::memory_order_relaxed);
+
+		auto const bucket_of = [delta](E d) { return static_cast<std::size_t>(d / delta); };
+		auto buckets = std::map<std::size_t, std::vector<std::size_t>>{{0, {source}}};
+
+		// Relaxes either the light or the heavy edges of every node in frontier, then files each
+		// node that got closer into the bucket for its new distance.
+		auto const relax = [&](std::vector<std::size_t> const& frontier, bool light) {
+			auto const relax_slice = [&](std::size_t first, std::size_t last, auto& out) {
+				for (auto f = first; f < last; ++f) {
+					auto const u = frontier[f];
+					auto const du = dist[u].load(std::memory_order_relaxed);
+					auto const targets = g.targets(u);
+					auto const weights = g.edge_weights(u);
+					for (auto i = std::size_t{0}; i < targets.size(); ++i) {
+						if ((weights[i] <= delta) == light
+						    && detail::atomic_min(dist[targets[i]], du + weights[i])) {
+							out.push_back(targets[i]);
+						}
+					}
+				}
+			};
+			for (auto const v : detail::parallel_collect(frontier.size(), threads, relax_slice)) {
+				buckets[bucket_of(dist[v].load(std::memory_order_relaxed))].push_back(v);
+			}
+		};
+
+		while (!buckets.empty()) {
+			auto const current = buckets.begin()->first;
+			auto settled = std::vector<std::size_t>{};
+			for (auto iter = buckets.begin(); iter != buckets.end() && iter->first == current;
+			     iter = buckets.begin()) {
+				auto frontier = std::move(iter->second);
+				buckets.erase(iter);
+				// a node filed into a later bucket may since have moved into this one
+				std::erase_if(frontier, [&](std::size_t v) {
+					return bucket_of(dist[v].load(std::memory_order_relaxed)) != current;
+				});
+				detail::sort_unique(frontier);
+				relax(frontier, true);
+				settled.insert(settled.end(), frontier.begin(), frontier.end());
+			}
+			detail::sort_unique(settled);
+			relax(settled, false);
+		}
+
+		auto res = std::vector<std::pair<N, E>>{};
+		for (auto i = std::size_t{0}; i < g.node_count(); ++i) {
+			auto const d = dist[i].load(std::memory_order_relaxed);
+			if (d != unreached) {
+				res.emplace_back(g.node_at(i), d);
+			}
+		}
+		return res;
+	}
+
+	// Freezes g and runs delta_stepping over the snapshot.
+	// Complexity: O(n + e) to freeze g, then as above.
+	template<typename N, typename E>
+	requires(std::is_arithmetic_v<E> && !std::is_same_v<E, bool>)
+	[[nodiscard]] auto delta_stepping(graph<N, E> const& g,
+	                                  N const& src,
+	                                  E delta,
+	                                  std::size_t threads = std::thread::hardware_concurrency())
+	   -> std::vector<std::pair<N, E>> {
+		return delta_stepping(freeze(g), src, delta, threads);
+	}
+
+	// A node reached by bfs, with the number of edges on the shortest path to it from src and the
+	// node that path arrives from. src is its own parent.
+	template<typename N>
+	struct bfs_visit {
+		N node;
+		std::size_t depth;
+		N parent;
+
+		auto operator==(bfs_visit const&) const -> bool = default;
+	};
+
+	template<typename N>
+	struct bfs_result {
+		// Every reachable node, sorted in ascending order of node.
+		std::vector<bfs_visit<N>> visits;
+		// The number of outgoing edges of every reachable node.
+		std::size_t edges_traversed = 0;
+		// Time spent on the traversal, excluding building visits.
+		std::chrono::duration<double> elapsed{};
+
+		// Returns: Traversed edges per second, the usual measure of BFS throughput.
+		[[nodiscard]] auto edges_per_second() const -> double {
+			return elapsed.count() > 0 ? static_cast<double>(edges_traversed) / elapsed.count() : 0;
+		}
+	};
+
+	// Breadth-first search from src using up to threads threads, one level at a time. Each level
+	// is expanded either top-down, where frontier nodes claim their unvisited successors, or
+	// bottom-up, where every unvisited node scans its predecessors for one in the frontier. A level
+	// goes bottom-up once the frontier's outgoing edges outnumber those of the unvisited nodes
+	// divided by 14, and back to top-down once the frontier holds under 1/24 of the nodes (the
+	// thresholds from Beamer et al.'s direction-optimizing BFS).
+	// Complexity: O(n + e) work for each level expanded bottom-up, and O(e) in total for the rest.
+	template<typename N, typename E>
+	[[nodiscard]] auto bfs(csr_view<N, E> const& g,
+	                       N const& src,
+	                       std::size_t threads = std::thread::hardware_concurrency())
+	   -> bfs_result<N> {
+		auto const source = g.index_of(src);
+		if (source == csr_view<N, E>::npos) {
+			throw std::runtime_error("Cannot call gdwg::bfs if src doesn't exist in the graph");
+		}
+
+		constexpr auto npos = csr_view<N, E>::npos;
+		constexpr auto alpha = std::size_t{14};
+		constexpr auto beta = std::size_t{24};
+		auto const start = std::chrono::steady_clock::now();
+		auto const n = g.node_count();
+
+		auto parent = std::vector<std::atomic<std::size_t>>(n);
+		for (auto& p : parent) {
+			p.store(npos, std::memory_order_relaxed);
+		}
+		auto depth = std::vector<std::size_t>(n, npos);
+		auto in_frontier = std::vector<char>{};
+		parent[source].store(source, std::memory_order_relaxed);
+		depth[source] = 0;
+
+		auto frontier = std::vector<std::size_t>{source};
+		auto level = std::size_t{0};
+
+		// Frontier nodes claim each unvisited successor; the first to do so becomes its parent.
+		auto const expand_top_down = [&](std::size_t first, std::size_t last, auto& out) {
+			for (auto f = first; f < last; ++f) {
+				for (auto const v : g.targets(frontier[f])) {
+					auto expected = npos;
+					if (parent[v].load(std::memory_order_relaxed) == npos
+					    && parent[v].compare_exchange_strong(expected,
+					                                         frontier[f],
+					                                         std::memory_order_relaxed)) {
+						depth[v] = level;
+						out.push_back(v);
+					}
+				}
+			}
+		};
+
+		// Unvisited nodes look for any predecessor in the frontier. Each node is only written by
+		// the thread scanning it, so no atomic update is needed.
+		auto const expand_bottom_up = [&](std::size_t first, std::size_t last, auto& out) {
+			for (auto v = first; v < last; ++v) {
+				if (depth[v] != npos) {
+					continue;
+				}
+				for (auto const u : g.sources(v)) {
+					if (in_frontier[u]) {
+						parent[v].store(u, std::memory_order_relaxed);
+						depth[v] = level;
+						out.push_back(v);
+						break;
+					}
+				}
+			}
+		};
+
+		auto frontier_edges = g.targets(source).size();
+		auto unvisited_edges = g.edge_count() - frontier_edges;
+		auto edges_traversed = frontier_edges;
+		auto bottom_up = false;
+		while (!frontier.empty()) {
+			++level;
+			if (!bottom_up && frontier_edges > unvisited_edges / alpha) {
+				bottom_up = true;
+			}
+			else if (bottom_up && frontier.size() < n / beta) {
+				bottom_up = false;
+			}
+
+			if (bottom_up) {
+				in_frontier.assign(n, 0);
+				for (auto const u : frontier) {
+					in_frontier[u] = 1;
+				}
+				frontier = detail::parallel_collect(n, threads, expand_bottom_up);
+			}
+			else {
+				frontier = detail::parallel_collect(frontier.size(), threads, expand_top_down);
+			}
+
+			frontier_edges = 0;
+			for (auto const v : frontier) {
+				frontier_edges += g.targets(v).size();
+			}
+			unvisited_edges -= frontier_edges;
+			edges_traversed += frontier_edges;
+		}
+
+		auto res = bfs_result<N>{};
+		res.elapsed = std::chrono::steady_clock::now() - start;
+		res.edges_traversed = edges_traversed;
+		for (auto v = std::size_t{0}; v < n; ++v) {
+			if (depth[v] != npos) {
+				res.visits.push_back(bfs_visit<N>{
+				   g.node_at(v),
+				   depth[v],
+				   g.node_at(parent[v].load(std::memory_order_relaxed)),
+				});
+			}
+		}
+		return res;
+	}
+
+	// Freezes g and runs bfs over the snapshot.
+	// Complexity: O(n + e) to freeze g, then as above.
+	template<typename N, typename E>
+	[[nodiscard]] auto bfs(graph<N, E> const& g,
+	                       N const& src,
+	                       std::size_t threads = std::thread::hardware_concurrency())
+	   -> bfs_result<N> {
+		return bfs(freeze(g), src, threads);
+	}
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHMS_HPP
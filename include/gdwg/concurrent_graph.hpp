@@ -0,0 +1,207 @@
+#ifndef GDWG_CONCURRENT_GRAPH_HPP
+#define GDWG_CONCURRENT_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// A graph shared between any number of reader threads and occasional writers. Readers work on
+	// immutable snapshots, so they never wait for a writer to finish. A writer copies the latest
+	// snapshot, applies a batch of changes to the copy through update(), and publishes it as the
+	// next snapshot. Old snapshots are freed once their last reader lets go of them. Writers are
+	// serialised among themselves, and each update costs a copy of the graph, so there are no
+	// single-edge modifiers; changes are gathered into one update() or insert_edges() instead.
+	//
+	// Reads go through a reader, which keeps the snapshot it last loaded and only checks an atomic
+	// version counter until a writer publishes, so readers share no lock and no reference count.
+	// The accessors below do the same through a reader kept per thread. Loading a snapshot, as
+	// snapshot() does, is the slow path: std::atomic<std::shared_ptr> is not lock-free in common
+	// standard libraries, and each load bumps the shared reference count.
+	template<typename N, typename E>
+	class concurrent_graph {
+	public:
+		class reader;
+
+		using snapshot_type = std::shared_ptr<graph<N, E> const>;
+
+		// --------------------------------------------
+		// Constructors
+		// --------------------------------------------
+
+		concurrent_graph()
+		: concurrent_graph(graph<N, E>{}) {}
+
+		explicit concurrent_graph(graph<N, E> g)
+		: current_{std::make_shared<graph<N, E> const>(std::move(g))}
+		, id_{next_id_.fetch_add(1, std::memory_order_relaxed)} {}
+
+		concurrent_graph(concurrent_graph const&) = delete;
+		auto operator=(concurrent_graph const&) -> concurrent_graph& = delete;
+
+		// --------------------------------------------
+		// Snapshots
+		// --------------------------------------------
+
+		// Returns: The latest published snapshot. It stays valid, and unchanged, for as long as it
+		// is held, so iterators taken from it can be used freely.
+		// Complexity: Constant, but it takes the lock guarding the snapshot pointer and touches its
+		// shared reference count. Repeated reads should go through a reader instead.
+		[[nodiscard]] auto snapshot() const -> snapshot_type {
+			return current_.load(std::memory_order_acquire);
+		}
+
+		// Returns: The number of snapshots published since construction.
+		[[nodiscard]] auto version() const noexcept -> std::uint64_t {
+			return version_.load(std::memory_order_acquire);
+		}
+
+		// --------------------------------------------
+		// Modifiers
+		// --------------------------------------------
+
+		// Calls f with a copy of the latest snapshot, then publishes the copy. Nothing is published
+		// if f throws.
+		// Returns: Whatever f returns.
+		// Complexity: O(n + e) for the copy, plus the cost of f.
+		template<typename F>
+		auto update(F f) -> decltype(f(std::declval<graph<N, E>&>())) {
+			auto const lock = std::scoped_lock(writer_);
+			auto next = std::make_shared<graph<N, E>>(*current_.load(std::memory_order_relaxed));
+			if constexpr (std::is_void_v<decltype(f(*next))>) {
+				f(*next);
+				publish(std::move(next));
+			}
+			else {
+				auto res = f(*next);
+				publish(std::move(next));
+				return res;
+			}
+		}
+
+		// Adds the edges in [first, last) in one update.
+		// Returns: The number of edges added.
+		// Complexity: O(n + e) for the copy, plus the cost of graph::insert_edges().
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t {
+			return update([&](graph<N, E>& g) { return g.insert_edges(first, last); });
+		}
+
+		// Publishes an empty graph without copying the current one.
+		auto clear() -> void {
+			auto const lock = std::scoped_lock(writer_);
+			publish(std::make_shared<graph<N, E>>());
+		}
+
+		// --------------------------------------------
+		// Accessors
+		// --------------------------------------------
+		// Each call answers from the latest snapshot, through a reader kept by the calling thread,
+		// so it costs an atomic load unless a writer has published since that thread's last query.
+		// A thread keeps the snapshot it last queried alive until its next query, and one that
+		// alternates between graphs reloads on every switch. Queries that need to agree with each
+		// other, or that return iterators, should share one reader's snapshot.
+
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return local_snapshot().is_node(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return local_snapshot().empty();
+		}
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			return local_snapshot().is_connected(src, dst);
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return local_snapshot().nodes();
+		}
+
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			return local_snapshot().weights(src, dst);
+		}
+
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			return local_snapshot().connections(src);
+		}
+
+		[[nodiscard]] auto node_count() const -> std::size_t {
+			return local_snapshot().node_count();
+		}
+
+		[[nodiscard]] auto edge_count() const -> std::size_t {
+			return local_snapshot().edge_count();
+		}
+
+	private:
+		std::atomic<snapshot_type> current_;
+		std::atomic<std::uint64_t> version_ = 0;
+		// Tells graphs apart in the per-thread readers, since one may reuse the address of another.
+		std::uint64_t id_;
+		std::mutex writer_;
+
+		static inline auto next_id_ = std::atomic<std::uint64_t>{1};
+
+		// Returns: The latest snapshot, as seen by the reader the calling thread keeps for the graph
+		// it last queried.
+		[[nodiscard]] auto local_snapshot() const -> graph<N, E> const& {
+			struct local_reader {
+				std::uint64_t id = 0;
+				std::uint64_t version = 0;
+				snapshot_type snapshot;
+			};
+			thread_local auto local = local_reader{};
+			auto const latest = version();
+			if (local.id != id_ || local.version != latest) {
+				local = local_reader{id_, latest, snapshot()};
+			}
+			return *local.snapshot;
+		}
+
+		// The snapshot is stored before the version is bumped, so a reader that sees the new
+		// version is guaranteed to load the new snapshot.
+		auto publish(snapshot_type next) -> void {
+			current_.store(std::move(next), std::memory_order_release);
+			version_.fetch_add(1, std::memory_order_release);
+		}
+	};
+
+	// A per-thread handle on a concurrent_graph that keeps the snapshot it last loaded. Loading a
+	// snapshot touches the shared reference count, so a reader only does so after a writer has
+	// published; otherwise refreshing costs a single atomic load. A reader must not be shared
+	// between threads.
+	template<typename N, typename E>
+	class concurrent_graph<N, E>::reader {
+	public:
+		explicit reader(concurrent_graph const& source)
+		: source_{&source}
+		, version_{source.version()}
+		, snapshot_{source.snapshot()} {}
+
+		// Returns: The latest published snapshot. The reference stays valid until the next call to
+		// snapshot() on this reader.
+		[[nodiscard]] auto snapshot() -> graph<N, E> const& {
+			auto const latest = source_->version();
+			if (latest != version_) {
+				version_ = latest;
+				snapshot_ = source_->snapshot();
+			}
+			return *snapshot_;
+		}
+
+	private:
+		concurrent_graph const* source_;
+		std::uint64_t version_;
+		snapshot_type snapshot_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_CONCURRENT_GRAPH_HPP
@@ -0,0 +1,222 @@
+#ifndef GDWG_CSR_FILE_HPP
+#define GDWG_CSR_FILE_HPP
+
+#include "gdwg/csr_view.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gdwg {
+	// Saves csr_view snapshots in a binary format that can be mapped straight back into memory. A
+	// file is a fixed header followed by the arrays of the view, each starting on a 64-byte
+	// boundary:
+	//
+	//     header | nodes[n] | offsets[n + 1] | targets[e] | weights[e] | in_offsets[n + 1] |
+	//     sources[e]
+	//
+	// The arrays are written exactly as they lie in memory, so the format is only defined for
+	// trivially copyable N and E, and a file can only be mapped on a platform with the same byte
+	// order, sizes and alignments it was written with. The header records these and map() checks
+	// them, along with the counts fitting in the file; it does not check the arrays, so files must
+	// come from a trusted source.
+	template<typename N, typename E>
+	struct csr_file {
+		static_assert(std::is_trivially_copyable_v<N> && std::is_trivially_copyable_v<E>,
+		              "gdwg::csr_file needs trivially copyable nodes and weights");
+		static_assert(sizeof(std::size_t) == sizeof(std::uint64_t),
+		              "gdwg::csr_file needs a 64-bit std::size_t");
+
+		struct header {
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t node_size;
+			std::uint32_t node_alignment;
+			std::uint32_t weight_size;
+			std::uint32_t weight_alignment;
+			std::uint64_t node_count;
+			std::uint64_t edge_count;
+		};
+
+		static constexpr auto magic = std::array<char, 8>{'G', 'D', 'W', 'G', 'C', 'S', 'R', '\0'};
+		static constexpr auto version = std::uint32_t{1};
+		static constexpr auto byte_order = std::uint32_t{0x01020304};
+		static constexpr auto alignment = std::size_t{64};
+
+		// Byte offsets of each array within a file. The counts may come from a file's header, so
+		// every array is checked to end within limit before its offset is computed, and nothing
+		// wraps around.
+		struct layout {
+			std::size_t nodes = 0;
+			std::size_t offsets = 0;
+			std::size_t targets = 0;
+			std::size_t weights = 0;
+			std::size_t in_offsets = 0;
+			std::size_t sources = 0;
+			std::size_t size = 0;
+			// Whether every array ends within limit.
+			bool fits = true;
+
+			layout(std::size_t node_count,
+			       std::size_t edge_count,
+			       std::size_t limit = std::numeric_limits<std::size_t>::max()) {
+				auto end = sizeof(header);
+				fits = end <= limit && node_count < std::numeric_limits<std::size_t>::max();
+				auto const place = [this, &end, limit](std::size_t count, std::size_t element_size) {
+					auto const padding = (alignment - end % alignment) % alignment;
+					if (!fits || padding > limit - end
+					    || count > (limit - end - padding) / element_size) {
+						fits = false;
+						return std::size_t{0};
+					}
+					auto const at = end + padding;
+					end = at + count * element_size;
+					return at;
+				};
+				nodes = place(node_count, sizeof(N));
+				offsets = place(node_count + 1, sizeof(std::size_t));
+				targets = place(edge_count, sizeof(std::size_t));
+				weights = place(edge_count, sizeof(E));
+				in_offsets = place(node_count + 1, sizeof(std::size_t));
+				sources = place(edge_count, sizeof(std::size_t));
+				size = end;
+			}
+		};
+
+		// Writes g to os.
+		// Complexity: O(n + e), where n is the number of stored nodes and e is the number of stored
+		// edges.
+		static auto write(csr_view<N, E> const& g, std::ostream& os) -> void {
+			auto const head = header{magic,
+			                         version,
+			                         byte_order,
+			                         sizeof(N),
+			                         alignof(N),
+			                         sizeof(E),
+			                         alignof(E),
+			                         g.node_count(),
+			                         g.edge_count()};
+			auto const at = layout(g.node_count(), g.edge_count());
+
+			auto written = std::size_t{0};
+			auto const put = [&os, &written](std::size_t offset, auto const& array) {
+				static constexpr auto padding = std::array<char, alignment>{};
+				os.write(padding.data(), static_cast<std::streamsize>(offset - written));
+				auto const bytes = std::as_bytes(std::span(array));
+				os.write(reinterpret_cast<char const*>(bytes.data()),
+				         static_cast<std::streamsize>(bytes.size()));
+				written = offset + bytes.size();
+			};
+			put(0, std::span(&head, 1));
+			put(at.nodes, g.nodes_);
+			put(at.offsets, g.offsets_);
+			put(at.targets, g.targets_);
+			put(at.weights, g.weights_);
+			put(at.in_offsets, g.in_offsets_);
+			put(at.sources, g.sources_);
+			if (!os) {
+				throw std::runtime_error("Cannot call gdwg::write_binary on a stream that can't be "
+				                         "written");
+			}
+		}
+
+		// Maps the file at path read-only. Pages are read in by the operating system as they are
+		// first touched, so this only reads the header.
+		// Returns: A view whose arrays are the mapped file. The file stays mapped until the view and
+		// all of its copies are destroyed.
+		// Complexity: O(1).
+		static auto map(std::filesystem::path const& path) -> csr_view<N, E> {
+			auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) {
+				throw std::runtime_error("Cannot call gdwg::map_binary on a file that can't be opened");
+			}
+			auto status = stat_type{};
+			auto const file_size = ::fstat(fd, &status) == 0 ? static_cast<std::size_t>(status.st_size)
+			                                                  : std::size_t{0};
+			auto* const address = file_size < sizeof(header)
+			                         ? MAP_FAILED
+			                         : ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			// the mapping keeps its own reference to the file
+			::close(fd);
+			if (address == MAP_FAILED) {
+				throw std::runtime_error("Cannot call gdwg::map_binary on a file that can't be mapped");
+			}
+			auto storage = std::shared_ptr<void const>(address, [file_size](void const* p) {
+				::munmap(const_cast<void*>(p), file_size);
+			});
+
+			auto const* const base = static_cast<std::byte const*>(address);
+			auto head = header{};
+			std::memcpy(&head, base, sizeof(header));
+			if (head.magic != magic || head.version != version || head.byte_order != byte_order
+			    || head.node_size != sizeof(N) || head.node_alignment != alignof(N)
+			    || head.weight_size != sizeof(E) || head.weight_alignment != alignof(E))
+			{
+				throw std::runtime_error("Cannot call gdwg::map_binary on a file that wasn't written "
+				                         "for this graph type");
+			}
+			auto const at = layout(head.node_count, head.edge_count, file_size);
+			if (!at.fits) {
+				throw std::runtime_error("Cannot call gdwg::map_binary on a file that is truncated");
+			}
+
+			auto const array = [base]<typename T>(std::size_t offset, std::size_t count) {
+				return std::span(reinterpret_cast<T const*>(base + offset), count);
+			};
+			auto g = csr_view<N, E>();
+			g.nodes_ = array.template operator()<N>(at.nodes, head.node_count);
+			g.offsets_ = array.template operator()<std::size_t>(at.offsets, head.node_count + 1);
+			g.targets_ = array.template operator()<std::size_t>(at.targets, head.edge_count);
+			g.weights_ = array.template operator()<E>(at.weights, head.edge_count);
+			g.in_offsets_ = array.template operator()<std::size_t>(at.in_offsets, head.node_count + 1);
+			g.sources_ = array.template operator()<std::size_t>(at.sources, head.edge_count);
+			g.storage_ = std::move(storage);
+			return g;
+		}
+
+	private:
+		using stat_type = struct ::stat;
+	};
+
+	// Writes g to the file at path, replacing it if it exists.
+	// Complexity: O(n + e).
+	template<typename N, typename E>
+	auto write_binary(csr_view<N, E> const& g, std::filesystem::path const& path) -> void {
+		auto os = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		csr_file<N, E>::write(g, os);
+	}
+
+	// Writes a snapshot of g to the file at path, replacing it if it exists.
+	// Complexity: O(n + e).
+	template<typename N, typename E>
+	auto write_binary(graph<N, E> const& g, std::filesystem::path const& path) -> void {
+		write_binary(freeze(g), path);
+	}
+
+	// Returns: A view of the graph written to the file at path, mapped without reading or copying
+	// its arrays.
+	// Complexity: O(1).
+	template<typename N, typename E>
+	[[nodiscard]] auto map_binary(std::filesystem::path const& path) -> csr_view<N, E> {
+		return csr_file<N, E>::map(path);
+	}
+} // namespace gdwg
+
+#endif // GDWG_CSR_FILE_HPP
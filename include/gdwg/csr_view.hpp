@@ -0,0 +1,436 @@
+#ifndef GDWG_CSR_VIEW_HPP
+#define GDWG_CSR_VIEW_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	template<typename N, typename E>
+	struct csr_file;
+
+	// A read-only snapshot of a graph in compressed sparse row form. Nodes are kept sorted in one
+	// array, and the outgoing edges of the i-th node occupy [offsets[i], offsets[i + 1]) of the
+	// parallel target and weight arrays, ordered by destination and then weight. Since nodes are
+	// sorted, ordering targets by index is the same as ordering them by value. The edges are also
+	// kept transposed, so that the incoming edges of a node are just as cheap to walk. Copies of a
+	// view share its arrays, so copying one is cheap.
+	template<typename N, typename E>
+	class csr_view {
+	public:
+		class iterator;
+
+		using value_type = typename graph<N, E>::value_type;
+
+		// --------------------------------------------
+		// Constructors
+		// --------------------------------------------
+
+		csr_view() = default;
+
+		// Compacts g into contiguous arrays.
+		// Complexity: O(n + e), where n is the number of stored nodes and e is the number of stored
+		// edges.
+		explicit csr_view(graph<N, E> const& g) {
+			auto arrays = std::make_shared<owned_arrays>();
+			auto& [nodes, offsets, targets, weights, in_offsets, sources] = *arrays;
+			nodes.reserve(g.graph_.size());
+			offsets.reserve(g.graph_.size() + 1);
+			offsets.push_back(0);
+
+			auto index_of = std::unordered_map<typename graph<N, E>::node_handle, std::size_t>{};
+			index_of.reserve(g.graph_.size());
+			for (auto iter = g.graph_.begin(); iter != g.graph_.end(); ++iter) {
+				index_of.emplace(graph<N, E>::handle_of(iter), nodes.size());
+				nodes.push_back(iter->first);
+			}
+
+			targets.reserve(g.edge_count());
+			if constexpr (std::is_same_v<E, bool>) {
+				weights = std::make_unique<bool[]>(g.edge_count());
+			}
+			else {
+				weights.reserve(g.edge_count());
+			}
+			for (auto const& conn : g.graph_) {
+				conn.second.edges.for_each([&](auto dst, E const& weight) {
+					if constexpr (std::is_same_v<E, bool>) {
+						weights[targets.size()] = weight;
+					}
+					else {
+						weights.push_back(weight);
+					}
+					targets.push_back(index_of.find(dst)->second);
+				});
+				offsets.push_back(targets.size());
+			}
+
+			// counting sort by destination; walking sources in order keeps each row sorted
+			in_offsets.assign(nodes.size() + 1, 0);
+			for (auto const dst : targets) {
+				++in_offsets[dst + 1];
+			}
+			std::partial_sum(in_offsets.begin(), in_offsets.end(), in_offsets.begin());
+			sources.resize(targets.size());
+			auto next = std::vector<std::size_t>(in_offsets.begin(), std::prev(in_offsets.end()));
+			for (auto src = std::size_t{0}; src < nodes.size(); ++src) {
+				for (auto edge = offsets[src]; edge < offsets[src + 1]; ++edge) {
+					sources[next[targets[edge]]++] = src;
+				}
+			}
+
+			nodes_ = nodes;
+			offsets_ = offsets;
+			targets_ = targets;
+			if constexpr (std::is_same_v<E, bool>) {
+				weights_ = std::span<bool const>(weights.get(), targets.size());
+			}
+			else {
+				weights_ = weights;
+			}
+			in_offsets_ = in_offsets;
+			sources_ = sources;
+			storage_ = std::move(arrays);
+		}
+
+		// Rebuilds a mutable graph holding the same nodes and edges, allocated from resource. The
+		// snapshot is already sorted, so the nodes are appended and the edges bulk inserted without
+		// sorting.
+		// Complexity: O(n + e + p log (n)), where p is the number of distinct (src, dst) pairs.
+		[[nodiscard]] auto
+		thaw(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const
+		   -> graph<N, E> {
+			auto g = graph<N, E>(nodes_.begin(), nodes_.end(), resource);
+			g.insert_edges(begin(), end());
+			return g;
+		}
+
+		// --------------------------------------------
+		// Accessors
+		// --------------------------------------------
+
+		// Returns: true if a node equivalent to value exists in the graph, and false otherwise.
+		// Complexity: O(log (n)) time.
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return std::binary_search(nodes_.begin(), nodes_.end(), value);
+		}
+
+		// Returns: true if there are no nodes in the graph, and false otherwise.
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
+		}
+
+		// Returns: true if an edge src → dst exists in the graph, and false otherwise.
+		// Complexity: O(log (n) + log (e)), where e is the number of outgoing edges of src.
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const src_index = index_of(src);
+			auto const dst_index = index_of(dst);
+			if (src_index == npos || dst_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::csr_view<N, E>::is_connected if src or dst "
+				                         "node don't exist in the graph");
+			}
+			auto const& [first, last] = std::ranges::equal_range(row(src_index), dst_index);
+			return first != last;
+		}
+
+		// Returns: A sequence of all stored nodes, sorted in ascending order.
+		// Complexity: O(n).
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return std::vector<N>(nodes_.begin(), nodes_.end());
+		}
+
+		// Returns: A sequence of weights from src to dst, sorted in ascending order.
+		// Complexity: O(log (n) + log (e) + k), where k is the number of weights returned.
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const src_index = index_of(src);
+			auto const dst_index = index_of(dst);
+			if (src_index == npos || dst_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::csr_view<N, E>::weights if src or dst node "
+				                         "don't exist in the graph");
+			}
+			auto const& [first, last] = std::ranges::equal_range(row(src_index), dst_index);
+			auto const weight_iter = weights_.begin() + (first - targets_.begin());
+			return std::vector<E>(weight_iter, weight_iter + (last - first));
+		}
+
+		// Returns: An iterator pointing to an edge equivalent to value_type{src, dst, weight}, or
+		// end() if no such edge exists.
+		// Complexity: O(log (n) + log (e)).
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const src_index = index_of(src);
+			auto const dst_index = index_of(dst);
+			if (src_index == npos || dst_index == npos) {
+				return end();
+			}
+
+			auto const edges = std::views::iota(offsets_[src_index], offsets_[src_index + 1]);
+			auto const edge = *std::ranges::partition_point(edges, [&](std::size_t i) {
+				return targets_[i] < dst_index || (targets_[i] == dst_index && weights_[i] < weight);
+			});
+			if (edge == offsets_[src_index + 1] || targets_[edge] != dst_index
+			    || weights_[edge] != weight) {
+				return end();
+			}
+			return iterator(this, src_index, edge);
+		}
+
+		// Returns: A sequence of nodes (found from any immediate outgoing edge) connected to src,
+		// sorted in ascending order, with respect to the connected nodes.
+		// Complexity: O(log (n) + e), where e is the number of outgoing edges of src.
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const src_index = index_of(src);
+			if (src_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::csr_view<N, E>::connections if src doesn't "
+				                         "exist in the graph");
+			}
+
+			auto res = std::vector<N>{};
+			auto const targets = row(src_index);
+			for (auto iter = targets.begin(); iter != targets.end(); ++iter) {
+				if (iter == targets.begin() || *iter != *std::prev(iter)) {
+					res.push_back(nodes_[*iter]);
+				}
+			}
+			return res;
+		}
+
+		// --------------------------------------------
+		// Index access
+		// --------------------------------------------
+		// Nodes are numbered by their position in nodes(), so algorithms running over the snapshot
+		// can keep per-node data in plain arrays.
+
+		static constexpr auto npos = static_cast<std::size_t>(-1);
+
+		// Returns: The number of stored nodes.
+		[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+			return nodes_.size();
+		}
+
+		// Returns: The number of stored edges.
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return targets_.size();
+		}
+
+		// Returns: The index of the node equivalent to value, or npos if there is none.
+		// Complexity: O(log (n)).
+		[[nodiscard]] auto index_of(N const& value) const -> std::size_t {
+			auto const iter = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (iter == nodes_.end() || value < *iter) {
+				return npos;
+			}
+			return static_cast<std::size_t>(iter - nodes_.begin());
+		}
+
+		// Returns: The node at index i.
+		[[nodiscard]] auto node_at(std::size_t i) const -> N const& {
+			return nodes_[i];
+		}
+
+		// Returns: The indices of the destinations of the outgoing edges of the node at index i,
+		// ordered by destination and then weight.
+		[[nodiscard]] auto targets(std::size_t i) const -> std::span<std::size_t const> {
+			return targets_.subspan(offsets_[i], offsets_[i + 1] - offsets_[i]);
+		}
+
+		// Returns: The indices of the sources of the incoming edges of the node at index i, sorted in
+		// ascending order. A source appears once per edge.
+		[[nodiscard]] auto sources(std::size_t i) const -> std::span<std::size_t const> {
+			return sources_.subspan(in_offsets_[i], in_offsets_[i + 1] - in_offsets_[i]);
+		}
+
+		// Returns: The weights of the outgoing edges of the node at index i, in the same order as
+		// targets(i).
+		[[nodiscard]] auto edge_weights(std::size_t i) const -> std::span<E const> {
+			return weights_.subspan(offsets_[i], offsets_[i + 1] - offsets_[i]);
+		}
+
+		// --------------------------------------------
+		// Iterator access
+		// --------------------------------------------
+
+		// Returns: An iterator pointing to the first element in the container.
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(this, row_of(0), 0);
+		}
+
+		// Returns: An iterator denoting the end of the iterable list that begin() points to.
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(this, nodes_.size(), targets_.size());
+		}
+
+		// --------------------------------------------
+		// Comparisons
+		// --------------------------------------------
+
+		// Returns: true if *this and other contain exactly the same nodes and edges, and false
+		// otherwise.
+		// Complexity: O(n + e).
+		[[nodiscard]] auto operator==(csr_view const& other) const -> bool {
+			// the transposed arrays follow from the others
+			return std::ranges::equal(nodes_, other.nodes_)
+			       && std::ranges::equal(offsets_, other.offsets_)
+			       && std::ranges::equal(targets_, other.targets_)
+			       && std::ranges::equal(weights_, other.weights_);
+		}
+
+		// --------------------------------------------
+		// Extractor
+		// --------------------------------------------
+
+		// Behaves as a formatted output function of os, producing the same output as the graph that
+		// was frozen.
+		friend auto operator<<(std::ostream& os, csr_view const& g) -> std::ostream& {
+			auto out = output_buffer(os);
+			for (auto src = std::size_t{0}; src < g.nodes_.size(); ++src) {
+				out.put(g.nodes_[src]);
+				out.put(" (\n");
+				for (auto edge = g.offsets_[src]; edge < g.offsets_[src + 1]; ++edge) {
+					out.put_edge(g.nodes_[g.targets_[edge]], g.weights_[edge]);
+				}
+				out.put(")\n");
+			}
+			out.flush();
+			return os;
+		}
+
+	private:
+		// std::vector<bool> packs its values into bits, which no span can point at, so bool weights
+		// are kept in a plain array of their own.
+		using weight_array =
+		   std::conditional_t<std::is_same_v<E, bool>, std::unique_ptr<bool[]>, std::vector<E>>;
+
+		// The arrays of a snapshot built in memory.
+		struct owned_arrays {
+			std::vector<N> nodes;
+			std::vector<std::size_t> offsets;
+			std::vector<std::size_t> targets;
+			weight_array weights;
+			std::vector<std::size_t> in_offsets;
+			std::vector<std::size_t> sources;
+		};
+
+		using output_buffer = typename graph<N, E>::output_buffer;
+
+		static constexpr auto empty_offsets = std::array<std::size_t, 1>{0};
+
+		// Keeps the arrays alive. They are never written after construction, so copies of a view
+		// share them, whether they were built in memory or mapped from a file by csr_file.
+		std::shared_ptr<void const> storage_;
+		std::span<N const> nodes_;
+		std::span<std::size_t const> offsets_ = empty_offsets;
+		std::span<std::size_t const> targets_;
+		std::span<E const> weights_;
+		std::span<std::size_t const> in_offsets_ = empty_offsets;
+		std::span<std::size_t const> sources_;
+
+		friend struct csr_file<N, E>;
+
+		// Returns the destination indices of the outgoing edges of the node at index src.
+		[[nodiscard]] auto row(std::size_t src) const {
+			auto const first = targets_.begin();
+			return std::ranges::subrange(first + static_cast<std::ptrdiff_t>(offsets_[src]),
+			                             first + static_cast<std::ptrdiff_t>(offsets_[src + 1]));
+		}
+
+		// Returns the index of the node whose row holds the edge at index edge.
+		[[nodiscard]] auto row_of(std::size_t edge) const -> std::size_t {
+			auto const iter = std::upper_bound(offsets_.begin(), offsets_.end(), edge);
+			return static_cast<std::size_t>(iter - offsets_.begin()) - 1;
+		}
+	};
+
+	template<typename N, typename E>
+	class csr_view<N, E>::iterator {
+	public:
+		using value_type = csr_view<N, E>::value_type;
+		using reference = value_type;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::bidirectional_iterator_tag;
+
+		// Value-initialises all members.
+		iterator() = default;
+
+		// Returns the current from, to, and weight.
+		auto operator*() const -> reference {
+			return value_type{view_->nodes_[node_],
+			                  view_->nodes_[view_->targets_[edge_]],
+			                  view_->weights_[edge_]};
+		}
+
+		// Advances *this to the next element in the iterable list.
+		auto operator++() -> iterator& {
+			++edge_;
+			while (node_ < view_->nodes_.size() && edge_ == view_->offsets_[node_ + 1]) {
+				++node_;
+			}
+			return *this;
+		}
+
+		// Advances *this to the next element in the iterable list and returns *this.
+		auto operator++(int) -> iterator {
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		// Advances *this to the previous element in the iterable list.
+		auto operator--() -> iterator& {
+			--edge_;
+			while (view_->offsets_[node_] > edge_) {
+				--node_;
+			}
+			return *this;
+		}
+
+		// Advances *this to the previous element in the iterable list and returns *this.
+		auto operator--(int) -> iterator {
+			auto temp = *this;
+			--*this;
+			return temp;
+		}
+
+		// Returns: true if *this and other are pointing to the same elements in the same iterable
+		// list, and false otherwise.
+		auto operator==(iterator const& other) const -> bool {
+			return view_ == other.view_ && edge_ == other.edge_;
+		}
+
+	private:
+		csr_view const* view_ = nullptr;
+		std::size_t node_ = 0;
+		std::size_t edge_ = 0;
+
+		// Constructs an iterator to the edge at index edge, which belongs to the node at index node.
+		explicit iterator(csr_view const* view, std::size_t node, std::size_t edge)
+		: view_{view}
+		, node_{node}
+		, edge_{edge} {}
+
+		friend class csr_view;
+	};
+
+	// Returns: A compressed sparse row snapshot of g.
+	template<typename N, typename E>
+	[[nodiscard]] auto freeze(graph<N, E> const& g) -> csr_view<N, E> {
+		return csr_view<N, E>(g);
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_CSR_VIEW_HPP
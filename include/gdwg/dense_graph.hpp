@@ -0,0 +1,766 @@
+#ifndef GDWG_DENSE_GRAPH_HPP
+#define GDWG_DENSE_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// A graph whose nodes are integral ids, with the core interface and ordering of graph<N, E>.
+	// Each id indexes straight into a vector of adjacency blocks, so a node is found in constant
+	// time and is never allocated on its own. The vector grows with the largest id stored rather
+	// than with the number of nodes, so ids should be dense, such as 0 to n - 1, and can't be
+	// negative.
+	//
+	// Not all of graph carries over: there are no memory resource constructors or resource(),
+	// lookups take N rather than any node_key, there is no insert_edge(src, dst) for unweighted
+	// graphs, and each edge stores its weight next to its destination even when E is empty.
+	template<typename N, typename E>
+	class dense_graph {
+		static_assert(std::is_integral_v<N>, "gdwg::dense_graph needs integral node ids");
+
+	public:
+		class iterator;
+		class neighbour_iterator;
+
+		using value_type = typename graph<N, E>::value_type;
+
+		// --------------------------------------------
+		// Constructors
+		// --------------------------------------------
+
+		dense_graph() noexcept = default;
+
+		dense_graph(std::initializer_list<N> il) {
+			std::for_each(il.begin(), il.end(), [this](auto const& i) { insert_node(i); });
+		}
+
+		template<typename InputIt>
+		dense_graph(InputIt first, InputIt last) {
+			std::for_each(first, last, [this](auto const& i) { insert_node(i); });
+		}
+
+		// Builds a graph holding every edge in [first, last), and every node that is the src or dst
+		// of one of those edges. The input may be unsorted and may hold duplicates.
+		// Complexity: O(k log (k) + m), where k=std::distance(first, last) and m is the largest id.
+		template<typename InputIt>
+		[[nodiscard]] static auto from_edges(InputIt first, InputIt last) -> dense_graph {
+			auto const batch = graph<N, E>::sorted_batch(first, last);
+			auto g = dense_graph();
+			for (auto const& [from, to, weight] : batch) {
+				g.insert_node(from);
+				g.insert_node(to);
+			}
+			// the batch is sorted, so every edge lands at the end of its source's block
+			for (auto const& [from, to, weight] : batch) {
+				g.nodes_[index_of(from)].edges.emplace_back(to, weight);
+				link(g.nodes_[index_of(to)], from);
+			}
+			g.edge_count_ = batch.size();
+			return g;
+		}
+
+		// other is left empty.
+		dense_graph(dense_graph&& other) noexcept
+		: nodes_{std::exchange(other.nodes_, {})}
+		, node_count_{std::exchange(other.node_count_, 0)}
+		, edge_count_{std::exchange(other.edge_count_, 0)} {}
+
+		auto operator=(dense_graph&& other) noexcept -> dense_graph& {
+			std::swap(nodes_, other.nodes_);
+			std::swap(node_count_, other.node_count_);
+			std::swap(edge_count_, other.edge_count_);
+			other.clear();
+			return *this;
+		}
+
+		dense_graph(dense_graph const& other) = default;
+		auto operator=(dense_graph const& other) -> dense_graph& = default;
+
+		// --------------------------------------------
+		// Modifiers
+		// --------------------------------------------
+
+		// Adds a new node with value value to the graph if, and only if, there is no node equivalent
+		// to value already stored.
+		// Complexity: Amortised constant.
+		auto insert_node(N const& value) -> bool {
+			if constexpr (std::is_signed_v<N>) {
+				if (value < 0) {
+					throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::insert_node on a "
+					                         "negative id");
+				}
+			}
+			auto const i = index_of(value);
+			if (i >= nodes_.max_size()) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::insert_node on an id "
+				                         "too large to index");
+			}
+			if (i >= nodes_.size()) {
+				nodes_.resize(i + 1);
+			}
+			if (nodes_[i].present) {
+				return false;
+			}
+			nodes_[i].present = true;
+			++node_count_;
+			return true;
+		}
+
+		// Adds a new edge representing src → dst with weight weight, if, and only if, there is no
+		// edge equivalent to value_type{src, dst, weight} already stored.
+		// Complexity: O(e), where e is the number of outgoing edges of src.
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			if (entry_of(src) == nullptr || entry_of(dst) == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::insert_edge when either "
+				                         "src or dst node does not exist");
+			}
+			return emplace_edge(src, dst, weight);
+		}
+
+		// Adds every edge in [first, last) that is not already stored. The batch is sorted once and
+		// merged into the block of each source.
+		// Returns: The number of edges added.
+		// Complexity: O(k log (k) + d), where k=std::distance(first, last) and d is the number of
+		// edges already stored at the sources in the batch.
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t {
+			auto const batch = graph<N, E>::sorted_batch(first, last);
+
+			// every endpoint is checked before anything is added, so a missing node leaves the graph
+			// untouched
+			for (auto const& [from, to, _] : batch) {
+				if (entry_of(from) == nullptr || entry_of(to) == nullptr) {
+					throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::insert_edges when "
+					                         "either src or dst node does not exist");
+				}
+			}
+
+			auto added = std::size_t{0};
+			for (auto run = batch.begin(); run != batch.end();) {
+				auto const src = run->from;
+				auto const run_end = std::find_if(run, batch.end(), [src](value_type const& value) {
+					return value.from != src;
+				});
+				auto& edges = nodes_[index_of(src)].edges;
+				auto merged = std::vector<edge>{};
+				merged.reserve(edges.size() + static_cast<std::size_t>(run_end - run));
+				auto iter = edges.begin();
+				for (; run != run_end; ++run) {
+					auto const value = edge{run->to, run->weight};
+					for (; iter != edges.end() && *iter < value; ++iter) {
+						merged.push_back(*iter);
+					}
+					if (iter != edges.end() && !(value < *iter)) {
+						continue;
+					}
+					merged.push_back(value);
+					link(nodes_[index_of(run->to)], src);
+					++added;
+				}
+				merged.insert(merged.end(), iter, edges.end());
+				edges = std::move(merged);
+			}
+			edge_count_ += added;
+			return added;
+		}
+
+		// Replaces the original data, old_data, stored at this particular node by the replacement
+		// data, new_data. Does nothing if new_data already exists as a node.
+		// Complexity: O(d × e), where d is the number of edges incident to old_data and e is the
+		// largest number of outgoing edges of a node they touch.
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			if (entry_of(old_data) == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::replace_node on a node "
+				                         "that doesn't exist");
+			}
+			if (!insert_node(new_data)) {
+				return false;
+			}
+			merge_node(old_data, new_data);
+			return true;
+		}
+
+		// The node equivalent to old_data in the graph are replaced with instances of new_data. After
+		// completing, every incoming and outgoing edge of old_data becomes an incoming/ougoing edge
+		// of new_data, except that duplicate edges shall be removed.
+		// Complexity: O(d × e), as for replace_node.
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			if (entry_of(old_data) == nullptr || entry_of(new_data) == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::merge_replace_node on "
+				                         "old or new data if they don't exist in the graph");
+			}
+			merge_node(old_data, new_data);
+		}
+
+		// Erases all nodes equivalent to value, including all incoming and outgoing edges.
+		// Complexity: O(d + e), where d is the number of edges incident to value and e is the
+		// largest number of outgoing edges of a node with an edge into value.
+		auto erase_node(N const& value) -> bool {
+			if (entry_of(value) == nullptr) {
+				return false;
+			}
+			erase_entry(value);
+			return true;
+		}
+
+		// Erases an edge representing src → dst with weight weight.
+		// Complexity: O(e), where e is the number of outgoing edges of src.
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto* const src_entry = entry_of(src);
+			auto* const dst_entry = entry_of(dst);
+			if (src_entry == nullptr || dst_entry == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::erase_edge on src or "
+				                         "dst if they don't exist in the graph");
+			}
+
+			auto const value = edge{dst, weight};
+			auto& edges = src_entry->edges;
+			auto const iter = std::lower_bound(edges.begin(), edges.end(), value);
+			if (iter == edges.end() || value < *iter) {
+				return false;
+			}
+			edges.erase(iter);
+			unlink(*dst_entry, src);
+			--edge_count_;
+			return true;
+		}
+
+		// Erases the edge pointed to by i.
+		// Complexity: O(e), where e is the number of outgoing edges of the source of i.
+		auto erase_edge(iterator i) -> iterator;
+
+		// Erases all edges between the iterators [i, s).
+		// Complexity: O(d + e), where d=std::distance(i, s) and e is the number of outgoing edges
+		// of the source of s.
+		auto erase_edge(iterator i, iterator s) -> iterator;
+
+		// Erases all nodes from the graph.
+		auto clear() noexcept -> void {
+			nodes_.clear();
+			node_count_ = 0;
+			edge_count_ = 0;
+		}
+
+		// --------------------------------------------
+		// Accessors
+		// --------------------------------------------
+
+		// Returns: true if a node equivalent to value exists in the graph, and false otherwise.
+		// Complexity: Constant.
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return entry_of(value) != nullptr;
+		}
+
+		// Returns: true if there are no nodes in the graph, and false otherwise.
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return node_count_ == 0;
+		}
+
+		// Returns: The number of stored nodes.
+		// Complexity: Constant.
+		[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+			return node_count_;
+		}
+
+		// Returns: The number of stored edges.
+		// Complexity: Constant.
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return edge_count_;
+		}
+
+		// Returns: The number of edges whose src is value.
+		// Complexity: Constant.
+		[[nodiscard]] auto out_degree(N const& value) const -> std::size_t {
+			auto const* const entry = entry_of(value);
+			if (entry == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::out_degree if value "
+				                         "doesn't exist in the graph");
+			}
+			return entry->edges.size();
+		}
+
+		// Returns: The number of edges whose dst is value.
+		// Complexity: Constant.
+		[[nodiscard]] auto in_degree(N const& value) const -> std::size_t {
+			auto const* const entry = entry_of(value);
+			if (entry == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::in_degree if value "
+				                         "doesn't exist in the graph");
+			}
+			return entry->in_degree;
+		}
+
+		// Returns: true if an edge src → dst exists in the graph, and false otherwise.
+		// Complexity: O(log (e)), where e is the number of outgoing edges of src.
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const* const src_entry = entry_of(src);
+			if (src_entry == nullptr || entry_of(dst) == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::is_connected if src or "
+				                         "dst node don't exist in the graph");
+			}
+			return !edges_to(*src_entry, dst).empty();
+		}
+
+		// Returns: A sequence of all stored nodes, sorted in ascending order.
+		// Complexity: O(m), where m is the largest id.
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto res = std::vector<N>{};
+			res.reserve(node_count_);
+			for (auto i = std::size_t{0}; i < nodes_.size(); ++i) {
+				if (nodes_[i].present) {
+					res.push_back(static_cast<N>(i));
+				}
+			}
+			return res;
+		}
+
+		// Returns: A sequence of weights from src to dst, sorted in ascending order.
+		// Complexity: O(log (e) + k), where e is the number of outgoing edges of src and k is the
+		// number of weights returned.
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const* const src_entry = entry_of(src);
+			if (src_entry == nullptr || entry_of(dst) == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::weights if src or dst "
+				                         "node don't exist in the graph");
+			}
+			auto const res = edges_to(*src_entry, dst) | std::views::values;
+			return std::vector<E>(res.begin(), res.end());
+		}
+
+		// Returns: An iterator pointing to an edge equivalent to value_type{src, dst, weight}, or
+		// end() if no such edge exists.
+		// Complexity: O(log (e)), where e is the number of outgoing edges of src.
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const* const src_entry = entry_of(src);
+			if (src_entry == nullptr || entry_of(dst) == nullptr) {
+				return end();
+			}
+			auto const value = edge{dst, weight};
+			auto const& edges = src_entry->edges;
+			auto const iter = std::lower_bound(edges.begin(), edges.end(), value);
+			if (iter == edges.end() || value < *iter) {
+				return end();
+			}
+			return iterator(this, index_of(src), static_cast<std::size_t>(iter - edges.begin()));
+		}
+
+		// Returns: A sequence of nodes (found from any immediate outgoing edge) connected to src,
+		// sorted in ascending order, with respect to the connected nodes.
+		// Complexity: O(e), where e is the number of outgoing edges of src.
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const* const src_entry = entry_of(src);
+			if (src_entry == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+			auto const& edges = src_entry->edges;
+			return std::vector<N>(neighbour_iterator(edges.begin(), edges.end()),
+			                      neighbour_iterator(edges.end(), edges.end()));
+		}
+
+		// --------------------------------------------
+		// Range access
+		// --------------------------------------------
+		// Views over the stored edges that allocate nothing. Like iterators, they are invalidated by
+		// any modifier.
+
+		// Returns: A view of (dst, weight) pairs for every outgoing edge of src, sorted by dst and
+		// then weight.
+		// Complexity: Constant.
+		[[nodiscard]] auto out_edges(N const& src) const -> std::span<std::pair<N, E> const> {
+			auto const* const src_entry = entry_of(src);
+			if (src_entry == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::out_edges if src "
+				                         "doesn't exist in the graph");
+			}
+			return src_entry->edges;
+		}
+
+		// Returns: A view of the nodes connected to src by an outgoing edge, in ascending order and
+		// without duplicates.
+		// Complexity: Constant.
+		[[nodiscard]] auto neighbours(N const& src) const
+		   -> std::ranges::subrange<neighbour_iterator> {
+			auto const* const src_entry = entry_of(src);
+			if (src_entry == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::neighbours if src "
+				                         "doesn't exist in the graph");
+			}
+			auto const& edges = src_entry->edges;
+			return {neighbour_iterator(edges.begin(), edges.end()),
+			        neighbour_iterator(edges.end(), edges.end())};
+		}
+
+		// Returns: A view of the weights from src to dst, sorted in ascending order.
+		// Complexity: O(log (e)), where e is the number of outgoing edges of src.
+		[[nodiscard]] auto weights_view(N const& src, N const& dst) const {
+			auto const* const src_entry = entry_of(src);
+			if (src_entry == nullptr || entry_of(dst) == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::dense_graph<N, E>::weights_view if src or "
+				                         "dst node don't exist in the graph");
+			}
+			return edges_to(*src_entry, dst) | std::views::values;
+		}
+
+		// --------------------------------------------
+		// Iterator access
+		// --------------------------------------------
+
+		// Returns: An iterator pointing to the first element in the container.
+		[[nodiscard]] auto begin() const -> iterator {
+			return first_edge_from(0);
+		}
+
+		// Returns: An iterator denoting the end of the iterable list that begin() points to.
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(this, nodes_.size(), 0);
+		}
+
+		// --------------------------------------------
+		// Comparisons
+		// --------------------------------------------
+
+		// Returns: true if *this and other contain exactly the same nodes and edges, and false
+		// otherwise.
+		// Complexity: O(m + e), where m is the largest id and e is the number of stored edges.
+		[[nodiscard]] auto operator==(dense_graph const& other) const -> bool {
+			if (node_count_ != other.node_count_ || edge_count_ != other.edge_count_) {
+				return false;
+			}
+			// with equal node counts, matching ids up to the shorter block vector leave no nodes
+			// past its end in either graph
+			auto const size = std::min(nodes_.size(), other.nodes_.size());
+			return std::equal(nodes_.begin(),
+			                  nodes_.begin() + static_cast<std::ptrdiff_t>(size),
+			                  other.nodes_.begin(),
+			                  [](node_entry const& lhs, node_entry const& rhs) {
+				                  return lhs.present == rhs.present && lhs.edges == rhs.edges;
+			                  });
+		}
+
+		// --------------------------------------------
+		// Extractor
+		// --------------------------------------------
+
+		// Behaves as a formatted output function of os, producing the same output as a graph<N, E>
+		// holding the same nodes and edges.
+		// Complexity: O(m + e), where m is the largest id and e is the number of stored edges.
+		friend auto operator<<(std::ostream& os, dense_graph const& g) -> std::ostream& {
+			auto out = output_buffer(os);
+			for (auto i = std::size_t{0}; i < g.nodes_.size(); ++i) {
+				if (!g.nodes_[i].present) {
+					continue;
+				}
+				out.put(static_cast<N>(i));
+				out.put(" (\n");
+				for (auto const& [dst, weight] : g.nodes_[i].edges) {
+					out.put_edge(dst, weight);
+				}
+				out.put(")\n");
+			}
+			out.flush();
+			return os;
+		}
+
+	private:
+		// An outgoing edge, as its destination and weight. Pairs order by destination and then
+		// weight, which is the order graph<N, E> keeps its edges in.
+		using edge = std::pair<N, E>;
+
+		// A node with edges into another, and how many edges it has there.
+		using source = std::pair<N, std::size_t>;
+
+		// The adjacency block of one id. The sources of a node's incoming edges are kept so that
+		// erasing it doesn't need a scan of every block.
+		struct node_entry {
+			std::vector<edge> edges;
+			std::vector<source> incoming;
+			std::size_t in_degree = 0;
+			bool present = false;
+		};
+
+		using output_buffer = typename graph<N, E>::output_buffer;
+
+		std::vector<node_entry> nodes_;
+		std::size_t node_count_ = 0;
+		std::size_t edge_count_ = 0;
+
+		static auto index_of(N const& value) -> std::size_t {
+			return static_cast<std::size_t>(value);
+		}
+
+		// Returns the block of the node value, or nullptr if there is no such node.
+		auto entry_of(N const& value) -> node_entry* {
+			if constexpr (std::is_signed_v<N>) {
+				if (value < 0) {
+					return nullptr;
+				}
+			}
+			auto const i = index_of(value);
+			return i < nodes_.size() && nodes_[i].present ? &nodes_[i] : nullptr;
+		}
+
+		// Looking a node up never modifies the graph, so the const overload can share the other.
+		auto entry_of(N const& value) const -> node_entry const* {
+			return const_cast<dense_graph&>(*this).entry_of(value);
+		}
+
+		// Returns the edges from the node with block entry to dst.
+		static auto edges_to(node_entry const& entry, N const& dst) {
+			return std::ranges::equal_range(entry.edges, dst, {}, &edge::first);
+		}
+
+		// Records an edge from src in the block of its destination.
+		static auto link(node_entry& dst, N const& src) -> void {
+			++dst.in_degree;
+			auto const iter = std::ranges::lower_bound(dst.incoming, src, {}, &source::first);
+			if (iter != dst.incoming.end() && iter->first == src) {
+				++iter->second;
+				return;
+			}
+			dst.incoming.emplace(iter, src, 1);
+		}
+
+		// Forgets one edge from src in the block of its destination.
+		static auto unlink(node_entry& dst, N const& src) -> void {
+			--dst.in_degree;
+			auto const iter = std::ranges::lower_bound(dst.incoming, src, {}, &source::first);
+			if (--iter->second == 0) {
+				dst.incoming.erase(iter);
+			}
+		}
+
+		// Adds src → dst with weight weight, if, and only if, it is not already stored.
+		auto emplace_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const value = edge{dst, weight};
+			auto& edges = nodes_[index_of(src)].edges;
+			auto const iter = std::lower_bound(edges.begin(), edges.end(), value);
+			if (iter != edges.end() && !(value < *iter)) {
+				return false;
+			}
+			edges.insert(iter, value);
+			link(nodes_[index_of(dst)], src);
+			++edge_count_;
+			return true;
+		}
+
+		// Moves every edge incident to old_data over to new_data, then erases the former.
+		auto merge_node(N const& old_data, N const& new_data) -> void {
+			// collect the replacement edges first, since inserting them may touch the blocks being
+			// walked here
+			auto replacements = std::vector<value_type>{};
+			auto const& old_entry = nodes_[index_of(old_data)];
+			for (auto const& [dst, weight] : old_entry.edges) {
+				replacements.push_back({new_data, dst != old_data ? dst : new_data, weight});
+			}
+			for (auto const& [src, _] : old_entry.incoming) {
+				if (src == old_data) {
+					continue;
+				}
+				for (auto const& [dst, weight] : edges_to(nodes_[index_of(src)], old_data)) {
+					replacements.push_back({src, new_data, weight});
+				}
+			}
+
+			for (auto const& [from, to, weight] : replacements) {
+				emplace_edge(from, to, weight);
+			}
+			erase_entry(old_data);
+		}
+
+		// Erases the node value, along with its incoming and outgoing edges.
+		auto erase_entry(N const& value) -> void {
+			auto& entry = nodes_[index_of(value)];
+			edge_count_ -= entry.edges.size();
+			for (auto const& [src, count] : entry.incoming) {
+				// self-loops were counted among the outgoing edges already
+				if (src != value) {
+					auto& src_entry = nodes_[index_of(src)];
+					auto const [first, last] = edges_to(src_entry, value);
+					src_entry.edges.erase(first, last);
+					edge_count_ -= count;
+				}
+			}
+			for (auto const& [dst, _] : entry.edges) {
+				if (dst != value) {
+					unlink(nodes_[index_of(dst)], value);
+				}
+			}
+
+			entry = node_entry{};
+			--node_count_;
+		}
+
+		// Returns an iterator to the first edge of the first node from node onwards that has any
+		// edges.
+		[[nodiscard]] auto first_edge_from(std::size_t node) const -> iterator {
+			for (; node < nodes_.size() && nodes_[node].edges.empty(); ++node) {
+			}
+			return iterator(this, node, 0);
+		}
+	};
+
+	template<typename N, typename E>
+	class dense_graph<N, E>::iterator {
+	public:
+		using value_type = dense_graph<N, E>::value_type;
+		using reference = value_type;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::bidirectional_iterator_tag;
+
+		// Value-initialises all members.
+		iterator() = default;
+
+		// Returns the current from, to, and weight.
+		auto operator*() const -> reference {
+			auto const& [dst, weight] = graph_->nodes_[node_].edges[edge_];
+			return value_type{static_cast<N>(node_), dst, weight};
+		}
+
+		// Advances *this to the next element in the iterable list.
+		auto operator++() -> iterator& {
+			if (++edge_ == graph_->nodes_[node_].edges.size()) {
+				*this = graph_->first_edge_from(node_ + 1);
+			}
+			return *this;
+		}
+
+		// Advances *this to the next element in the iterable list and returns *this.
+		auto operator++(int) -> iterator {
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		// Advances *this to the previous element in the iterable list.
+		auto operator--() -> iterator& {
+			while (edge_ == 0) {
+				edge_ = graph_->nodes_[--node_].edges.size();
+			}
+			--edge_;
+			return *this;
+		}
+
+		// Advances *this to the previous element in the iterable list and returns *this.
+		auto operator--(int) -> iterator {
+			auto temp = *this;
+			--*this;
+			return temp;
+		}
+
+		// Returns: true if *this and other are pointing to the same elements in the same iterable
+		// list, and false otherwise.
+		auto operator==(iterator const& other) const -> bool {
+			return graph_ == other.graph_ && node_ == other.node_ && edge_ == other.edge_;
+		}
+
+	private:
+		dense_graph const* graph_ = nullptr;
+		std::size_t node_ = 0;
+		std::size_t edge_ = 0;
+
+		// Constructs an iterator to the edge-th outgoing edge of the node with id node.
+		explicit iterator(dense_graph const* g, std::size_t node, std::size_t edge)
+		: graph_{g}
+		, node_{node}
+		, edge_{edge} {}
+
+		friend class dense_graph;
+	};
+
+	// Walks the distinct destinations of a node's outgoing edges.
+	template<typename N, typename E>
+	class dense_graph<N, E>::neighbour_iterator {
+	public:
+		using value_type = N;
+		using reference = N const&;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		neighbour_iterator() = default;
+
+		auto operator*() const -> reference {
+			return iter_->first;
+		}
+
+		auto operator++() -> neighbour_iterator& {
+			auto const node = iter_->first;
+			for (++iter_; iter_ != end_ && iter_->first == node; ++iter_) {
+			}
+			return *this;
+		}
+
+		auto operator++(int) -> neighbour_iterator {
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		auto operator==(neighbour_iterator const& other) const -> bool {
+			return iter_ == other.iter_;
+		}
+
+	private:
+		using edges_iter = typename std::vector<edge>::const_iterator;
+
+		edges_iter iter_;
+		edges_iter end_;
+
+		explicit neighbour_iterator(edges_iter iter, edges_iter end)
+		: iter_{iter}
+		, end_{end} {}
+
+		friend class dense_graph;
+	};
+
+	template<typename N, typename E>
+	auto dense_graph<N, E>::erase_edge(iterator i) -> iterator {
+		auto& edges = nodes_[i.node_].edges;
+		auto const iter = edges.begin() + static_cast<std::ptrdiff_t>(i.edge_);
+		unlink(nodes_[index_of(iter->first)], static_cast<N>(i.node_));
+		--edge_count_;
+
+		// the edges after the erased one shift down into its place
+		edges.erase(iter);
+		if (i.edge_ != edges.size()) {
+			return i;
+		}
+		return first_edge_from(i.node_ + 1);
+	}
+
+	template<typename N, typename E>
+	auto dense_graph<N, E>::erase_edge(iterator i, iterator s) -> iterator {
+		// each source's edges in [i, s) are contiguous, so they go in one erase per source; only
+		// the source of s keeps edges after its run, and they shift down to where the run began
+		auto first = i.edge_;
+		for (auto node = i.node_; node < nodes_.size(); ++node, first = 0) {
+			auto& edges = nodes_[node].edges;
+			auto const last = node == s.node_ ? s.edge_ : edges.size();
+			auto const run_begin = edges.begin() + static_cast<std::ptrdiff_t>(first);
+			auto const run_end = edges.begin() + static_cast<std::ptrdiff_t>(last);
+			for (auto const& [dst, _] : std::ranges::subrange(run_begin, run_end)) {
+				unlink(nodes_[index_of(dst)], static_cast<N>(node));
+			}
+			edges.erase(run_begin, run_end);
+			edge_count_ -= last - first;
+			if (node == s.node_) {
+				return iterator(this, node, first);
+			}
+		}
+		return end();
+	}
+} // namespace gdwg
+
+#endif // GDWG_DENSE_GRAPH_HPP
@@ -2,18 +2,82 @@
 #define GDWG_GRAPH_HPP
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <concepts>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <locale>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <ranges>
 #include <set>
+#include <span>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 // This will not compile straight away
 namespace gdwg {
+	template<typename N, typename E>
+	class csr_view;
+	template<typename N, typename E>
+	class dense_graph;
+	template<typename N, typename E>
+	class matrix_view;
+
+	// Customises how graphs store nodes of type N. Specialise it with a hasher to have every graph
+	// of N keep an open-addressing hash index of its nodes alongside the ordered map, e.g.
+	//
+	//     template<>
+	//     struct gdwg::graph_traits<std::string> {
+	//         using hasher = std::hash<std::string>;
+	//     };
+	//
+	// Finding a node by value then takes O(1) expected time instead of O(log (n)) comparisons,
+	// for a few more bytes per node and a little more work on insertion and erasure. Nodes are
+	// still iterated in order. hasher must agree with operator== on N.
+	template<typename N>
+	struct graph_traits {
+		using hasher = void;
+	};
+
+	// The weight of every edge in a graph that only records which nodes are connected. It takes
+	// no space in a stored edge, all weights compare equal, and graph<N, unweighted> adds
+	// insert_edge(src, dst) and friends that leave the weight out. Edges of such graphs are
+	// printed without a weight.
+	struct unweighted {
+		auto operator<=>(unweighted const&) const = default;
+	};
+
+	// Whether edges weighted by E are printed, and read back, without a weight. Only unweighted
+	// is by default, so any other weight type keeps its own operator<<, empty or not. Specialise it
+	// to true for an empty weight type that should print like unweighted.
+	template<typename E>
+	inline constexpr bool omits_weight = std::is_same_v<E, unweighted>;
+
+	// A type that graph<N, E> accepts wherever it looks up an existing node. Keys that order
+	// against N with operator< in both directions, such as std::string_view or char const* for
+	// std::string nodes, are compared with the stored nodes as they are, so finding a node never
+	// constructs an N. Any other key must convert to N, and is converted once per lookup. So is an
+	// arithmetic key that converts to N, or a key that converts to arithmetic N, since comparing
+	// mixed arithmetic types does not follow N's ordering (-1 < 0u is false).
+	template<typename K, typename N>
+	concept node_key = std::convertible_to<K const&, N> || requires(K const& key, N const& node) {
+		{ key < node } -> std::convertible_to<bool>;
+		{ node < key } -> std::convertible_to<bool>;
+	};
+
 	template<typename N, typename E>
 	class graph {
 	public:
@@ -21,11 +85,12 @@ namespace gdwg {
 		// Iterator [gdwg.iterator]
 		// --------------------------------------------
 		class iterator;
+		class neighbour_iterator;
 
 		struct value_type {
 			N from;
 			N to;
-			E weight;
+			[[no_unique_address]] E weight;
 		};
 
 		// --------------------------------------------
@@ -34,44 +99,153 @@ namespace gdwg {
 
 		graph() noexcept = default;
 
-		graph(std::initializer_list<N> il)
-		: graph_{graph_container{}} {
-			std::for_each(il.begin(), il.end(), [this](auto const& i) { insert_node(i); });
+		// Every constructor taking a memory resource allocates all of the graph's nodes and edges
+		// from it, so a graph backed by an arena can be released in one go. resource must outlive
+		// the graph.
+		explicit graph(std::pmr::memory_resource* resource) noexcept
+		: graph_(resource)
+		, index_(resource) {}
+
+		graph(std::initializer_list<N> il,
+		      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: graph_(resource)
+		, index_(resource) {
+			std::for_each(il.begin(), il.end(), [this](auto const& i) { append_node(i); });
 		}
 
 		template<typename InputIt>
-		graph(InputIt first, InputIt last)
-		: graph_{graph_container{}} {
-			std::for_each(first, last, [this](auto const& i) { insert_node(i); });
+		graph(InputIt first,
+		      InputIt last,
+		      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: graph_(resource)
+		, index_(resource) {
+			std::for_each(first, last, [this](auto const& i) { append_node(i); });
 		}
 
+		// Builds a graph holding every edge in [first, last), and every node that is the src or dst
+		// of one of those edges. The input may be unsorted and may hold duplicates: it is sorted
+		// once, and each node's edges are then built in a single pass.
+		// Complexity: O(k log (k)), where k=std::distance(first, last).
+		template<typename InputIt>
+		[[nodiscard]] static auto
+		from_edges(InputIt first,
+		           InputIt last,
+		           std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> graph {
+			auto const batch = sorted_batch(first, last);
+
+			// the batch is already sorted by src, so only the dsts need sorting before the two are
+			// merged
+			auto srcs = std::vector<N>{};
+			auto dsts = std::vector<N>{};
+			dsts.reserve(batch.size());
+			for (auto const& [from, to, _] : batch) {
+				if (srcs.empty() || srcs.back() != from) {
+					srcs.push_back(from);
+				}
+				dsts.push_back(to);
+			}
+			std::sort(dsts.begin(), dsts.end());
+			dsts.erase(std::unique(dsts.begin(), dsts.end()), dsts.end());
+			auto endpoints = std::vector<N>{};
+			endpoints.reserve(srcs.size() + dsts.size());
+			std::set_union(srcs.begin(),
+			               srcs.end(),
+			               dsts.begin(),
+			               dsts.end(),
+			               std::back_inserter(endpoints));
+
+			// endpoints is sorted, so each node is appended in constant time and the i-th node of g
+			// is endpoints[i]
+			auto g = graph(endpoints.begin(), endpoints.end(), resource);
+			auto handles = std::vector<node_handle>{};
+			handles.reserve(endpoints.size());
+			for (auto iter = g.graph_.begin(); iter != g.graph_.end(); ++iter) {
+				handles.push_back(handle_of(iter));
+			}
+
+			auto sources = std::vector<node_handle>{};
+			auto edges = std::vector<edge>{};
+			sources.reserve(batch.size());
+			edges.reserve(batch.size());
+			auto src = endpoints.begin();
+			for (auto const& [from, to, weight] : batch) {
+				// the batch is sorted by from, so the source only ever moves forwards
+				for (; *src < from; ++src) {
+				}
+				auto const dst = std::lower_bound(endpoints.begin(), endpoints.end(), to);
+				sources.push_back(handles[static_cast<std::size_t>(src - endpoints.begin())]);
+				auto const dst_index = static_cast<std::size_t>(dst - endpoints.begin());
+				edges.push_back(edge{handles[dst_index], weight});
+			}
+			g.insert_sorted_edges(sources, edges);
+			return g;
+		}
+
+		// The memory resource moves along with the nodes and edges, so other is left empty and
+		// allocating from the resource *this had before.
 		graph(graph&& other) noexcept
-		: graph_{std::exchange(other.graph_, graph_container{})} {};
+		: graph_{std::exchange(other.graph_, graph_container(other.resource()))}
+		, index_{std::exchange(other.index_, node_index(other.resource()))}
+		, edge_count_{std::exchange(other.edge_count_, 0)} {};
 
 		auto operator=(graph&& other) noexcept -> graph& {
 			std::swap(graph_, other.graph_);
-			other.graph_ = graph_container{};
+			std::swap(index_, other.index_);
+			std::swap(edge_count_, other.edge_count_);
+			other.clear();
 			return *this;
 		};
 
+		// Like the standard std::pmr containers, a copy allocates from the default memory resource
+		// rather than from other's.
 		graph(graph const& other)
-		: graph_{graph_container{}} {
-			auto const& other_nodes = other.nodes();
-			for (auto const& node : other_nodes) {
-				insert_node(node);
+		: graph(other, std::pmr::get_default_resource()) {}
+
+		// other is already sorted and free of duplicates, so its structure is cloned directly: nodes
+		// are appended in order, and each node's edges keep their order with their destinations
+		// remapped to the cloned nodes.
+		// Complexity: O(n + e + s log (s)), where s is the largest number of distinct nodes with
+		// an edge into a single node.
+		graph(graph const& other, std::pmr::memory_resource* resource)
+		: graph_(resource)
+		, index_(resource)
+		, edge_count_{other.edge_count_} {
+			auto clone_of = std::unordered_map<node_handle, node_handle>{};
+			clone_of.reserve(other.graph_.size());
+			index_.reserve(other.graph_.size());
+			for (auto iter = other.graph_.begin(); iter != other.graph_.end(); ++iter) {
+				auto const clone =
+				   graph_.emplace_hint(graph_.end(), iter->first, node_entry(resource));
+				index_.insert(clone);
+				clone_of.emplace(handle_of(iter), handle_of(clone));
 			}
 
-			for (auto const& conn : other.graph_) {
-				for (auto const& edge : conn.second) {
-					insert_edge(*conn.first, edge->first, edge->second);
+			auto sources = std::vector<typename source_index::value_type>{};
+			auto clone = graph_.begin();
+			for (auto const& [_, entry] : other.graph_) {
+				auto& edges = clone->second.edges;
+				edges.reserve(entry.edges.groups().size(), entry.edges.size());
+				entry.edges.for_each([&](node_handle dst, E const& weight) {
+					edges.push_back(clone_of.find(dst)->second, weight);
+				});
+
+				// the incoming index is ordered by handle, which the remapping doesn't preserve
+				sources.clear();
+				for (auto const& [src, count] : entry.incoming) {
+					sources.emplace_back(clone_of.find(src)->second, count);
 				}
+				std::sort(sources.begin(), sources.end(), [](auto const& lhs, auto const& rhs) {
+					return std::less<>{}(lhs.first, rhs.first);
+				});
+				clone->second.incoming.merge(sources);
+				++clone;
 			}
-		};
+		}
 
+		// *this keeps allocating from its own memory resource.
 		auto operator=(graph const& other) -> graph& {
 			if (this != &other) {
-				auto copy = other;
-				std::swap(copy, *this);
+				*this = graph(other, resource());
 			}
 			return *this;
 		};
@@ -82,130 +256,172 @@ namespace gdwg {
 
 		// Adds a new node with value value to the graph if, and only if, there is no node equivalent
 		// to value already stored.
+		// Complexity: O(log (n)).
 		auto insert_node(N const& value) -> bool {
-			if (is_node(value)) {
-				return false;
-			}
-			graph_.emplace(std::make_unique<N>(value), edge_set{});
-			return true;
+			return emplace_node(value).second;
 		};
 
 		// Adds a new edge representing src → dst with weight weight, if, and only if, there is no
 		// edge equivalent to value_type{src, dst, weight} already stored.
-		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (!is_node(src) || !is_node(dst)) {
+		// Complexity: O(log (n) + e), where e is the number of outgoing edges of src.
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		auto insert_edge(Src const& src, Dst const& dst, E const& weight) -> bool {
+			auto const src_iter = lookup(src);
+			auto const dst_iter = lookup(dst);
+			if (src_iter == graph_.end() || dst_iter == graph_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src "
 				                         "or dst node does not exist");
 			}
 
-			auto const& src_iter = graph_.find(src);
+			// the edge set refuses duplicates itself, so there is no separate search for one
+			return emplace_edge(handle_of(src_iter), handle_of(dst_iter), weight);
+		}
 
-			// look for duplicate connection
-			if (src_iter->second.find(std::make_pair(dst, weight)) != src_iter->second.end()) {
-				return false;
-			}
+		// Adds a new edge representing src → dst to a graph whose edges carry no weight, such as
+		// graph<N, unweighted>.
+		// Complexity: O(log (n) + e), as for insert_edge(src, dst, weight).
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		requires std::is_empty_v<E>
+		auto insert_edge(Src const& src, Dst const& dst) -> bool {
+			return insert_edge(src, dst, E{});
+		}
 
-			// graph[src] = unique_ptr(<dst, weight>)
-			return (src_iter->second.emplace(std::make_unique<edge>(std::make_pair(dst, weight)))).second;
+		// Adds every edge in [first, last) that is not already stored. The batch is sorted once and
+		// merged into the edges of each source, rather than being searched for edge by edge.
+		// Returns: The number of edges added.
+		// Complexity: O(k log (k) + p log (n) + d), where k=std::distance(first, last), p is the
+		// number of distinct (src, dst) pairs in the batch, and d is the number of edges already
+		// stored at the sources in the batch.
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t {
+			auto const batch = sorted_batch(first, last);
+
+			// every endpoint is found before anything is added, so a missing node leaves the graph
+			// untouched
+			auto sources = std::vector<node_handle>{};
+			auto edges = std::vector<edge>{};
+			sources.reserve(batch.size());
+			edges.reserve(batch.size());
+			auto src_iter = graph_.end();
+			auto dst_iter = graph_.end();
+			for (auto const& [from, to, weight] : batch) {
+				if (src_iter == graph_.end() || src_iter->first != from) {
+					src_iter = lookup(from);
+					dst_iter = graph_.end();
+				}
+				if (dst_iter == graph_.end() || dst_iter->first != to) {
+					dst_iter = lookup(to);
+				}
+				if (src_iter == graph_.end() || dst_iter == graph_.end()) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edges when either "
+					                         "src or dst node does not exist");
+				}
+				sources.push_back(handle_of(src_iter));
+				edges.push_back(edge{handle_of(dst_iter), weight});
+			}
+			return insert_sorted_edges(sources, edges);
 		}
 
 		// Replaces the original data, old_data, stored at this particular node by the replacement
 		// data, new_data. Does nothing if new_data already exists as a node.
+		// Complexity: O(log (n) + d log (n + d) + s), where d is the number of edges incident to
+		// old_data and s is the combined size of the edge sets and incoming indices of its
+		// neighbours, which shift as edges are moved.
 		auto replace_node(N const& old_data, N const& new_data) -> bool {
-			if (!is_node(old_data)) {
+			auto const old_iter = lookup(old_data);
+			if (old_iter == graph_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that "
 				                         "doesn't exist");
 			}
 
-			if (is_node(new_data)) {
+			auto const [new_iter, inserted] = emplace_node(new_data);
+			if (!inserted) {
 				return false;
 			}
 
-			insert_node(new_data);
-
-			merge_replace_node(old_data, new_data);
-
+			merge_node(old_iter, new_iter);
 			return true;
 		}
 
 		// The node equivalent to old_data in the graph are replaced with instances of new_data. After
 		// completing, every incoming and outgoing edge of old_data becomes an incoming/ougoing edge
 		// of new_data, except that duplicate edges shall be removed.
+		// Complexity: O(log (n) + d log (n + d) + s), where d is the number of edges incident to
+		// old_data and s is the combined size of the edge sets and incoming indices of its
+		// neighbours, which shift as edges are moved.
 		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
-			if (!is_node(old_data) || !is_node(new_data)) {
+			auto const old_iter = lookup(old_data);
+			auto const new_iter = lookup(new_data);
+			if (old_iter == graph_.end() || new_iter == graph_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or "
 				                         "new data if they don't exist in the graph");
 			}
-
-			for (auto const& conn : graph_) {
-				if (*conn.first == old_data) {
-					for (auto const& edge : conn.second) {
-						edge->first != old_data ? insert_edge(new_data, edge->first, edge->second)
-						                        : insert_edge(new_data, new_data, edge->second);
-					}
-				}
-				else {
-					for (auto const& edge : conn.second) {
-						if (edge->first == old_data) {
-							insert_edge(*conn.first, new_data, edge->second);
-						}
-					}
-				}
-			}
-			erase_node(old_data);
+			merge_node(old_iter, new_iter);
 		}
 
 		// Erases all nodes equivalent to value, including all incoming and outgoing edges.
-		auto erase_node(N const& value) -> bool {
-			if (!is_node(value)) {
+		// Complexity: O(log (n) + d log (d) + s), where d is the number of edges incident to value and
+		// s is the combined size of the edge sets and incoming indices of its neighbours, which
+		// shift as its edges are removed from them.
+		template<node_key<N> K = N>
+		auto erase_node(K const& value) -> bool {
+			auto const node_iter = lookup(value);
+			if (node_iter == graph_.end()) {
 				return false;
 			}
-
-			for (auto& conn : graph_) {
-				std::erase_if(conn.second, [&value](auto const& edge) { return edge->first == value; });
-			}
-
-			graph_.erase(graph_.find(value)->first);
+			erase_entry(node_iter);
 			return true;
 		}
 
-		// Erases an edge representing src → dst with weight weight.
-		// Complexity: O(log (n) + e), where n is the total number of stored nodes and e is the total
-		// number of stored edges.
-		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (!is_node(src) || !is_node(dst)) {
+		// Erases an edge representing src → dst with weight weight. The edge is found with a binary
+		// search over the nodes src has an edge to, then another over the weights to dst; only
+		// shifting the edges stored after it takes linear time.
+		// Complexity: O(log (n) + e), where n is the number of stored nodes and e is the number of
+		// outgoing edges of src.
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		auto erase_edge(Src const& src, Dst const& dst, E const& weight) -> bool {
+			auto const src_iter = lookup(src);
+			auto const dst_iter = lookup(dst);
+			if (src_iter == graph_.end() || dst_iter == graph_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if "
 				                         "they don't exist in the graph");
 			}
 
-			if (!is_connected(src, dst)) {
+			auto& src_edges = src_iter->second.edges;
+			auto const edge_iter = src_edges.find(handle_of(dst_iter), weight);
+			if (edge_iter == src_edges.end()) {
 				return false;
 			}
 
-			auto const& src_node = graph_.find(src);
-			auto& src_node_edges = src_node->second;
-			auto const& edge_iter = src_node_edges.find(std::make_pair(dst, weight));
-
-			// edge doesn't exist
-			if (edge_iter == src_node_edges.end()) {
-				return false;
-			}
-
-			src_node_edges.erase(edge_iter);
+			src_edges.erase(edge_iter);
+			unlink(handle_of(src_iter), handle_of(dst_iter));
 			return true;
 		}
 
+		// Erases an edge representing src → dst from a graph whose edges carry no weight.
+		// Complexity: O(log (n) + e), as for erase_edge(src, dst, weight).
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		requires std::is_empty_v<E>
+		auto erase_edge(Src const& src, Dst const& dst) -> bool {
+			return erase_edge(src, dst, E{});
+		}
+
 		// Erases the edge pointed to by i.
-		// Complexity: Amortised constant time.
+		// Complexity: O(d), where d is the number of outgoing edges stored after i in its source
+		// node.
 		auto erase_edge(iterator i) -> iterator;
 
 		// Erases all edges between the iterators [i, s).
-		// Complexity O(d), where d=std::distance(i, s).
+		// Complexity: O(m + e + k), where m is the number of nodes from the source of i to the source
+		// of s, e is the number of outgoing edges of those nodes, and k is the combined size of the
+		// incoming indices of the destinations whose edges are erased.
 		auto erase_edge(iterator i, iterator s) -> iterator;
 
 		// Erases all nodes from the graph.
 		auto clear() noexcept -> void {
 			graph_.clear();
+			index_.clear();
+			edge_count_ = 0;
 		}
 
 		// --------------------------------------------
@@ -214,8 +430,9 @@ namespace gdwg {
 
 		// Returns: true if a node equivalent to value exists in the graph, and false otherwise.
 		// Complexity: O(log (n)) time.
-		[[nodiscard]] auto is_node(N const& value) const -> bool {
-			return graph_.find(value) != graph_.end();
+		template<node_key<N> K = N>
+		[[nodiscard]] auto is_node(K const& value) const -> bool {
+			return lookup(value) != graph_.end();
 		}
 
 		// Returns: true if there are no nodes in the graph, and false otherwise.
@@ -223,14 +440,59 @@ namespace gdwg {
 			return graph_.empty();
 		}
 
+		// Returns: The memory resource the graph's nodes and edges are allocated from.
+		[[nodiscard]] auto resource() const noexcept -> std::pmr::memory_resource* {
+			return graph_.get_allocator().resource();
+		}
+
+		// Returns: The number of stored nodes.
+		// Complexity: Constant.
+		[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+			return graph_.size();
+		}
+
+		// Returns: The number of stored edges.
+		// Complexity: Constant.
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return edge_count_;
+		}
+
+		// Returns: The number of edges whose src is value.
+		// Complexity: O(log (n)).
+		template<node_key<N> K = N>
+		[[nodiscard]] auto out_degree(K const& value) const -> std::size_t {
+			auto const node_iter = lookup(value);
+			if (node_iter == graph_.end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::out_degree if value doesn't "
+				                         "exist in the graph");
+			}
+			return node_iter->second.edges.size();
+		}
+
+		// Returns: The number of edges whose dst is value.
+		// Complexity: O(log (n)).
+		template<node_key<N> K = N>
+		[[nodiscard]] auto in_degree(K const& value) const -> std::size_t {
+			auto const node_iter = lookup(value);
+			if (node_iter == graph_.end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_degree if value doesn't "
+				                         "exist in the graph");
+			}
+			return node_iter->second.incoming.edge_count();
+		}
+
 		// Returns: true if an edge src → dst exists in the graph, and false otherwise.
-		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
-			if (!is_node(src) || !is_node(dst)) {
+		// Complexity: O(log (n) + log (d)), where d is the number of distinct nodes src has an edge
+		// to.
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto is_connected(Src const& src, Dst const& dst) const -> bool {
+			auto const src_iter = lookup(src);
+			auto const dst_iter = lookup(dst);
+			if (src_iter == graph_.end() || dst_iter == graph_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected if src or dst "
 				                         "node don't exist in the graph");
 			}
-			auto const& src_edges = graph_.find(src)->second;
-			return src_edges.find(dst) != src_edges.end();
+			return src_iter->second.edges.contains(handle_of(dst_iter));
 		}
 
 		// Returns: A sequence of all stored nodes, sorted in ascending order.
@@ -239,61 +501,129 @@ namespace gdwg {
 			auto res = std::vector<N>{};
 			res.reserve(graph_.size());
 			for (auto const& conn : graph_) {
-				res.push_back(*conn.first);
+				res.push_back(conn.first);
 			}
 			return res;
 		}
 
 		// Returns: A sequence of weights from src to dst, sorted in ascending order.
-		// Complexity: O(log (n) + e), where n is the number of stored nodes and e is the number of
-		// stored edges.
-		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
-			if (!is_node(src) || !is_node(dst)) {
+		// Complexity: O(log (n) + log (d) + k), where d is the number of distinct nodes src has an
+		// edge to and k is the number of weights returned.
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto weights(Src const& src, Dst const& dst) const -> std::vector<E> {
+			auto const src_iter = lookup(src);
+			auto const dst_iter = lookup(dst);
+			if (src_iter == graph_.end() || dst_iter == graph_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node "
 				                         "don't exist in the graph");
 			}
-			auto res = std::vector<E>{};
-			for (auto const& conn : graph_.find(src)->second) {
-				if (conn->first == dst) {
-					res.push_back(conn->second);
-				}
-			}
-			return res;
+			auto const res = edge_weights(src_iter, dst_iter);
+			return std::vector<E>(res.begin(), res.end());
 		}
 
 		// Returns: An iterator pointing to an edge equivalent to value_type{src, dst, weight}, or
 		// end() if no such edge exists.
 		// Complexity: O(log (n) + log (e)), where n is the number of stored nodes and e is the number
 		// of stored edges.
-		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto find(Src const& src, Dst const& dst, E const& weight) const -> iterator {
 			// log(n)
-			auto const& graph_iter = graph_.find(src);
+			auto const& graph_iter = lookup(src);
 			if (graph_iter == graph_.end()) {
 				return end();
 			}
 
+			auto const& dst_iter = lookup(dst);
+			if (dst_iter == graph_.end()) {
+				return end();
+			}
+
 			// log(e)
-			auto edge_iter = graph_iter->second.find(std::make_pair(dst, weight));
-			if (edge_iter == graph_iter->second.end()) {
+			auto edge_iter = graph_iter->second.edges.find(handle_of(dst_iter), weight);
+			if (edge_iter == graph_iter->second.edges.end()) {
 				return end();
 			}
 			return iterator(graph_iter, graph_.end(), edge_iter);
-		};
+		}
+
+		// Returns: An iterator pointing to the edge src → dst in a graph whose edges carry no
+		// weight, or end() if there is no such edge.
+		// Complexity: O(log (n) + log (e)), as for find(src, dst, weight).
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		requires std::is_empty_v<E>
+		[[nodiscard]] auto find(Src const& src, Dst const& dst) const -> iterator {
+			return find(src, dst, E{});
+		}
 
 		// Returns: A sequence of nodes (found from any immediate outgoing edge) connected to src,
 		// sorted in ascending order, with respect to the connected nodes.
-		// Complexity: O(log (n) + e), where e is the number of outgoing edges associated with src.
-		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
-			if (!is_node(src)) {
+		// Complexity: O(log (n) + d), where d is the number of distinct nodes src has an edge to.
+		template<node_key<N> K = N>
+		[[nodiscard]] auto connections(K const& src) const -> std::vector<N> {
+			auto const src_iter = lookup(src);
+			if (src_iter == graph_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't "
 				                         "exist in the graph");
 			}
+			auto const groups = src_iter->second.edges.groups();
+			return std::vector<N>(neighbour_iterator(groups.data()),
+			                      neighbour_iterator(groups.data() + groups.size()));
+		}
 
-			auto res = std::set<N>{};
-			for (auto const& conn : graph_.find(src)->second) {
-				res.emplace(conn->first);
+		// --------------------------------------------
+		// Range access
+		// --------------------------------------------
+		// Views over the stored edges that allocate nothing. Like iterators, they are invalidated by
+		// any modifier.
+
+		// Returns: A view of (dst, weight) pairs for every outgoing edge of src, sorted by dst and
+		// then weight.
+		// Complexity: O(log (n)).
+		template<node_key<N> K = N>
+		[[nodiscard]] auto out_edges(K const& src) const {
+			auto const src_iter = lookup(src);
+			if (src_iter == graph_.end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::out_edges if src doesn't "
+				                         "exist in the graph");
 			}
-			return std::vector<N>(res.begin(), res.end());
+			auto const& edges = src_iter->second.edges;
+			return std::ranges::subrange(edges.begin(), edges.end())
+			       | std::views::transform([](edge_ref const& value) {
+				         return std::pair<N const&, weight_reference>(value_of(value.first),
+				                                                      value.second);
+			         });
+		}
+
+		// Returns: A view of the nodes connected to src by an outgoing edge, in ascending order and
+		// without duplicates.
+		// Complexity: O(log (n)).
+		template<node_key<N> K = N>
+		[[nodiscard]] auto neighbours(K const& src) const
+		   -> std::ranges::subrange<neighbour_iterator> {
+			auto const src_iter = lookup(src);
+			if (src_iter == graph_.end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::neighbours if src doesn't "
+				                         "exist in the graph");
+			}
+			auto const groups = src_iter->second.edges.groups();
+			return {neighbour_iterator(groups.data()),
+			        neighbour_iterator(groups.data() + groups.size())};
+		}
+
+		// Returns: The weights from src to dst, sorted in ascending order, as a std::span<E const>
+		// over where they are stored. bool weights are packed into bits, so for them it is a
+		// subrange instead.
+		// Complexity: O(log (n) + log (d)), where d is the number of distinct nodes src has an edge
+		// to.
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto weights_view(Src const& src, Dst const& dst) const {
+			auto const src_iter = lookup(src);
+			auto const dst_iter = lookup(dst);
+			if (src_iter == graph_.end() || dst_iter == graph_.end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights_view if src or dst "
+				                         "node don't exist in the graph");
+			}
+			return edge_weights(src_iter, dst_iter);
 		}
 
 		// --------------------------------------------
@@ -302,12 +632,12 @@ namespace gdwg {
 
 		// Returns: An iterator pointing to the first element in the container.
 		[[nodiscard]] auto begin() const -> iterator {
-			return iterator(graph_.begin(), graph_.end(), {});
+			return iterator(graph_.begin(), graph_.end());
 		}
 
 		// Returns: An iterator denoting the end of the iterable list that begin() points to.
 		[[nodiscard]] auto end() const -> iterator {
-			return iterator(graph_.end(), graph_.end(), {});
+			return iterator(graph_.end(), graph_.end());
 		}
 
 		// --------------------------------------------
@@ -319,27 +649,17 @@ namespace gdwg {
 		// Complexity: O(n + e) where n is the sum of stored nodes in *this and other, and e is the
 		// sum of stored edges in *this and other.
 		[[nodiscard]] auto operator==(graph const& other) const -> bool {
-			auto const& this_nodes = nodes();
-			auto const& other_nodes = other.nodes();
-
-			if (empty() != other.empty() || this_nodes != other_nodes) {
+			// Both graphs are ordered the same way, so they are walked in lockstep; node and edge
+			// counts are compared first to bail out before comparing any values.
+			if (edge_count_ != other.edge_count_) {
 				return false;
 			}
-
-			for (auto const& node : this_nodes) {
-				auto const& this_conns = connections(node);
-				auto const& other_conns = other.connections(node);
-				if (this_conns != other_conns) {
-					return false;
-				}
-
-				for (auto const& conn : this_conns) {
-					if (weights(node, conn) != other.weights(node, conn)) {
-						return false;
-					}
-				}
-			}
-			return true;
+			auto const same_node = [](auto const& lhs, auto const& rhs) {
+				return lhs.second.edges.size() == rhs.second.edges.size() && lhs.first == rhs.first
+				       && lhs.second.edges.same_edges(rhs.second.edges);
+			};
+			return graph_.size() == other.graph_.size()
+			       && std::equal(graph_.begin(), graph_.end(), other.graph_.begin(), same_node);
 		}
 
 		// --------------------------------------------
@@ -347,75 +667,1104 @@ namespace gdwg {
 		// --------------------------------------------
 
 		// Behaves as a formatted output function of os.
+		// Complexity: O(n + e), where n is the number of stored nodes and e is the number of stored
+		// edges.
 		friend auto operator<<(std::ostream& os, graph const& g) -> std::ostream& {
-			if (g.empty()) {
-				os << "";
-				return os;
+			auto out = output_buffer(os);
+			for (auto const& [node, entry] : g.graph_) {
+				out.put(node);
+				out.put(" (\n");
+				entry.edges.for_each(
+				   [&out](node_handle dst, E const& weight) { out.put_edge(value_of(dst), weight); });
+				out.put(")\n");
 			}
-
-			for (auto const& src : g.nodes()) {
-				os << src << " ";
-				os << "(\n";
-				for (auto const& edge : g.graph_.find(src)->second) {
-					os << "  " << edge->first << " | " << edge->second << "\n";
-				}
-				os << ")\n";
-			}
-
+			out.flush();
 			return os;
 		}
 
 	private:
-		using node_ptr = std::unique_ptr<N>;
-		using edge = std::pair<N, E>;
-		using edge_ptr = std::unique_ptr<edge>;
+		friend class csr_view<N, E>;
+		friend class dense_graph<N, E>;
+		friend class matrix_view<N, E>;
+
+		// Allocates from a memory resource, like std::pmr::polymorphic_allocator, but moves and swaps
+		// along with its container. Moving a graph then hands its storage over as it is, which keeps
+		// every node handle valid, instead of reallocating each element from the target's resource.
+		template<typename T>
+		class resource_allocator {
+		public:
+			using value_type = T;
+			using propagate_on_container_move_assignment = std::true_type;
+			using propagate_on_container_swap = std::true_type;
+
+			template<typename U>
+			struct rebind {
+				using other = resource_allocator<U>;
+			};
+
+			resource_allocator() noexcept = default;
+
+			// NOLINTNEXTLINE(google-explicit-constructor)
+			resource_allocator(std::pmr::memory_resource* resource) noexcept
+			: resource_{resource} {}
+
+			template<typename U>
+			// NOLINTNEXTLINE(google-explicit-constructor)
+			resource_allocator(resource_allocator<U> const& other) noexcept
+			: resource_{other.resource()} {}
+
+			[[nodiscard]] auto allocate(std::size_t n) -> T* {
+				return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+			}
+
+			auto deallocate(T* p, std::size_t n) noexcept -> void {
+				resource_->deallocate(p, n * sizeof(T), alignof(T));
+			}
+
+			// Elements are constructed as polymorphic_allocator would construct them, so node values
+			// that take an allocator, such as std::pmr::string, allocate from the same resource.
+			template<typename U, typename... Args>
+			auto construct(U* p, Args&&... args) -> void {
+				auto const alloc = std::pmr::polymorphic_allocator<>(resource_);
+				std::uninitialized_construct_using_allocator(p, alloc, std::forward<Args>(args)...);
+			}
+
+			[[nodiscard]] auto resource() const noexcept -> std::pmr::memory_resource* {
+				return resource_;
+			}
+
+			template<typename U>
+			auto operator==(resource_allocator<U> const& other) const noexcept -> bool {
+				return resource_ == other.resource() || resource_->is_equal(*other.resource());
+			}
+
+		private:
+			std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+		};
+
+		template<typename T>
+		using resource_vector = std::vector<T, resource_allocator<T>>;
+
+		struct node_entry;
+
+		// Points to a node's element in graph_, which holds the node's value itself. Elements of a
+		// std::map are never relocated, so a handle, and the value it holds, stays valid until its
+		// node is erased.
+		using node_handle = std::pair<N const, node_entry>*;
+
+		// An edge refers to its destination through a handle, so every N is stored exactly once. An
+		// empty weight, such as unweighted, takes no space.
+		struct edge {
+			node_handle first;
+			[[no_unique_address]] E second;
+		};
 
 		struct graph_map_comparator {
 			using is_transparent = void;
-			auto operator()(node_ptr const& lhs, node_ptr const& rhs) const -> bool {
-				return *lhs < *rhs;
+			auto operator()(N const& lhs, N const& rhs) const -> bool {
+				return lhs < rhs;
 			}
 
-			auto operator()(node_ptr const& lhs, N const& rhs) const noexcept -> bool {
-				return *lhs < rhs;
+			// Keys are compared with the stored values as they are, so they never need to be N.
+			template<typename K>
+			auto operator()(N const& lhs, K const& rhs) const -> bool {
+				return lhs < rhs;
 			}
 
-			auto operator()(N const& lhs, node_ptr const& rhs) const noexcept -> bool {
-				return lhs < *rhs;
+			template<typename K>
+			auto operator()(K const& lhs, N const& rhs) const -> bool {
+				return lhs < rhs;
 			}
 		};
 
-		struct edge_set_comparator {
-			using is_transparent = void;
-			auto operator()(edge_ptr const& lhs, edge_ptr const& rhs) const -> bool {
-				if (lhs->first != rhs->first) {
-					return lhs->first < rhs->first;
+		// The weights of an edge_set are stored contiguously, except for bool weights, which
+		// std::vector packs into bits and hands out by value.
+		static constexpr auto packed_weights = std::is_same_v<E, bool>;
+		using weight_reference = std::conditional_t<packed_weights, bool, E const&>;
+		using weight_run =
+		   std::conditional_t<packed_weights,
+		                      std::ranges::subrange<typename resource_vector<bool>::const_iterator>,
+		                      std::span<E const>>;
+
+		// An edge as edge_set walks it: the destination, and the weight where it is stored.
+		struct edge_ref {
+			node_handle first;
+			weight_reference second;
+		};
+
+		// Orders edges by destination value, then weight. Handles are unique per node, so equal
+		// destinations are detected with a pointer comparison and only distinct destinations need
+		// their values compared.
+		static auto edge_less(node_handle lhs_dst,
+		                      E const& lhs_weight,
+		                      node_handle rhs_dst,
+		                      E const& rhs_weight) -> bool {
+			if (lhs_dst != rhs_dst) {
+				return value_of(lhs_dst) < value_of(rhs_dst);
+			}
+			return lhs_weight < rhs_weight;
+		}
+
+		// The outgoing edges of a node, grouped by destination. Each destination is stored once in
+		// groups_, sorted by value, and its weights form one sorted run of weights_; the runs are
+		// stored back to back in the same order. Finding a destination is a binary search over the
+		// distinct destinations, finding a weight is then a binary search within its run, and
+		// iteration is a linear walk. Inserting or erasing an edge shifts the edges after it.
+		//
+		// Edges that carry no weight, such as those of graph<N, unweighted>, have at most one edge
+		// per destination, so their groups record no run and weights_ stores nothing.
+		class edge_set {
+		public:
+			static constexpr auto weightless = std::is_empty_v<E>;
+
+			struct no_run_end {};
+
+			// A destination, and one past the last index of its run in weights_. Without weights, the
+			// i-th group's run is just [i, i + 1), so it isn't recorded.
+			struct group {
+				node_handle dst;
+				[[no_unique_address]] std::conditional_t<weightless, no_run_end, std::size_t> end;
+			};
+
+			// Stands in for weights_ when the edges carry no weight.
+			struct no_weights {
+				explicit no_weights(std::pmr::memory_resource*) noexcept {}
+			};
+
+			using weight_store = std::conditional_t<weightless, no_weights, resource_vector<E>>;
+
+			// Walks every edge of an edge_set, by destination and then weight.
+			class const_iterator {
+			public:
+				using value_type = edge_ref;
+				using reference = edge_ref;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::input_iterator_tag;
+				using iterator_concept = std::bidirectional_iterator_tag;
+
+				const_iterator() = default;
+
+				auto operator*() const -> reference {
+					return edge_ref{group_->dst, set_->weight_at(index_)};
+				}
+
+				auto operator++() -> const_iterator& {
+					if constexpr (weightless) {
+						++group_;
+						++index_;
+					}
+					else if (++index_ == group_->end) {
+						++group_;
+					}
+					return *this;
+				}
+
+				auto operator++(int) -> const_iterator {
+					auto temp = *this;
+					++*this;
+					return temp;
+				}
+
+				auto operator--() -> const_iterator& {
+					auto const i = static_cast<std::size_t>(group_ - set_->groups_.data());
+					if (--index_ < set_->run_begin(i)) {
+						--group_;
+					}
+					return *this;
+				}
+
+				auto operator--(int) -> const_iterator {
+					auto temp = *this;
+					--*this;
+					return temp;
+				}
+
+				auto operator==(const_iterator const& other) const noexcept -> bool {
+					return index_ == other.index_;
+				}
+
+			private:
+				edge_set const* set_ = nullptr;
+				group const* group_ = nullptr;
+				std::size_t index_ = 0;
+
+				const_iterator(edge_set const* set, std::size_t group, std::size_t index)
+				: set_{set}
+				, group_{set->groups_.data() + group}
+				, index_{index} {}
+
+				friend class edge_set;
+			};
+
+			explicit edge_set(std::pmr::memory_resource* resource)
+			: groups_(resource)
+			, weights_(resource) {}
+
+			[[nodiscard]] auto begin() const noexcept -> const_iterator {
+				return const_iterator(this, 0, 0);
+			}
+
+			[[nodiscard]] auto end() const noexcept -> const_iterator {
+				return const_iterator(this, groups_.size(), size());
+			}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return groups_.empty();
+			}
+
+			// Returns: The number of edges.
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				if constexpr (weightless) {
+					return groups_.size();
+				}
+				else {
+					return weights_.size();
+				}
+			}
+
+			[[nodiscard]] auto groups() const noexcept -> std::span<group const> {
+				return groups_;
+			}
+
+			// Calls f(dst, weight) for every edge, in order. Cheaper than walking the iterators when
+			// f writes through a char pointer, as printing does, since the loop state stays local.
+			template<typename F>
+			auto for_each(F f) const -> void {
+				if constexpr (weightless) {
+					for (auto const& [dst, _] : groups_) {
+						f(dst, no_weight);
+					}
+				}
+				else {
+					auto weight = weights_.begin();
+					for (auto const& [dst, end] : groups_) {
+						for (auto const last = weights_.begin() + static_cast<std::ptrdiff_t>(end);
+						     weight != last;
+						     ++weight) {
+							f(dst, *weight);
+						}
+					}
+				}
+			}
+
+			// Returns: true if other holds edges to equal destinations with equal weights.
+			[[nodiscard]] auto same_edges(edge_set const& other) const -> bool {
+				auto const same_group = [](group const& lhs, group const& rhs) {
+					if constexpr (weightless) {
+						return value_of(lhs.dst) == value_of(rhs.dst);
+					}
+					else {
+						return lhs.end == rhs.end && value_of(lhs.dst) == value_of(rhs.dst);
+					}
+				};
+				if constexpr (weightless) {
+					return std::ranges::equal(groups_, other.groups_, same_group);
+				}
+				else {
+					return weights_ == other.weights_
+					       && std::ranges::equal(groups_, other.groups_, same_group);
+				}
+			}
+
+			// Returns: The weights of the edges to dst, in ascending order.
+			[[nodiscard]] auto run(node_handle dst) const -> weight_run {
+				auto const i = lower_bound(dst);
+				if (i == groups_.size() || groups_[i].dst != dst) {
+					return {};
+				}
+				return run_at(i);
+			}
+
+			[[nodiscard]] auto contains(node_handle dst) const -> bool {
+				auto const i = lower_bound(dst);
+				return i != groups_.size() && groups_[i].dst == dst;
+			}
+
+			// Returns an iterator to the edge to dst with weight weight, or end() if there is none.
+			[[nodiscard]] auto find(node_handle dst, E const& weight) const -> const_iterator {
+				auto const i = lower_bound(dst);
+				if (i == groups_.size() || groups_[i].dst != dst) {
+					return end();
+				}
+				auto const weights = run_at(i);
+				auto const iter = std::lower_bound(weights.begin(), weights.end(), weight);
+				if (iter == weights.end() || weight < *iter) {
+					return end();
+				}
+				auto const index = run_begin(i) + static_cast<std::size_t>(iter - weights.begin());
+				return const_iterator(this, i, index);
+			}
+
+			// Inserts an edge to dst with weight weight at its sorted position, unless an equivalent
+			// edge is already stored.
+			auto emplace(node_handle dst, E const& weight) -> bool {
+				auto const i = lower_bound(dst);
+				auto const found = i != groups_.size() && groups_[i].dst == dst;
+				if constexpr (weightless) {
+					if (!found) {
+						groups_.insert(groups_.begin() + static_cast<std::ptrdiff_t>(i), group{dst, {}});
+					}
+					return !found;
+				}
+				else {
+					auto at = run_begin(i);
+					if (found) {
+						auto const weights = run_at(i);
+						auto const iter = std::lower_bound(weights.begin(), weights.end(), weight);
+						if (iter != weights.end() && !(weight < *iter)) {
+							return false;
+						}
+						at += static_cast<std::size_t>(iter - weights.begin());
+					}
+					else {
+						groups_.insert(groups_.begin() + static_cast<std::ptrdiff_t>(i), group{dst, at});
+					}
+					weights_.insert(weights_.begin() + static_cast<std::ptrdiff_t>(at), weight);
+					shift_ends(i, 1);
+					return true;
+				}
+			}
+
+			// Merges sorted, which is ordered by edge_less, into the set. Edges that are already
+			// stored are skipped, and on_insert is called with each edge that is added.
+			template<typename Callback>
+			auto merge(std::span<edge const> sorted, Callback on_insert) -> void {
+				auto merged = edge_set(groups_.get_allocator().resource());
+				merged.reserve(groups_.size() + sorted.size(), size() + sorted.size());
+				auto iter = begin();
+				for (auto const& value : sorted) {
+					for (; iter != end()
+					       && edge_less((*iter).first, (*iter).second, value.first, value.second);
+					     ++iter) {
+						merged.push_back((*iter).first, (*iter).second);
+					}
+					if (iter != end()
+					    && !edge_less(value.first, value.second, (*iter).first, (*iter).second)) {
+						continue;
+					}
+					merged.push_back(value.first, value.second);
+					on_insert(value);
+				}
+				for (; iter != end(); ++iter) {
+					merged.push_back((*iter).first, (*iter).second);
+				}
+				*this = std::move(merged);
+			}
+
+			auto reserve(std::size_t groups, std::size_t edges) -> void {
+				groups_.reserve(groups);
+				if constexpr (!weightless) {
+					weights_.reserve(edges);
+				}
+			}
+
+			// Appends an edge to dst with weight weight, which must not sort before any stored edge.
+			auto push_back(node_handle dst, E const& weight) -> void {
+				if constexpr (weightless) {
+					groups_.push_back(group{dst, {}});
+				}
+				else {
+					weights_.push_back(weight);
+					if (!groups_.empty() && groups_.back().dst == dst) {
+						++groups_.back().end;
+					}
+					else {
+						groups_.push_back(group{dst, weights_.size()});
+					}
+				}
+			}
+
+			// Erases the edge at pos.
+			// Returns: An iterator to the edge after it.
+			auto erase(const_iterator pos) -> const_iterator {
+				auto const i = static_cast<std::size_t>(pos.group_ - groups_.data());
+				if constexpr (weightless) {
+					groups_.erase(groups_.begin() + static_cast<std::ptrdiff_t>(i));
+				}
+				else {
+					weights_.erase(weights_.begin() + static_cast<std::ptrdiff_t>(pos.index_));
+					shift_ends(i, -1);
+					if (groups_[i].end == run_begin(i)) {
+						groups_.erase(groups_.begin() + static_cast<std::ptrdiff_t>(i));
+					}
+					else if (groups_[i].end == pos.index_) {
+						return const_iterator(this, i + 1, pos.index_);
+					}
+				}
+				return const_iterator(this, i, pos.index_);
+			}
+
+			// Erases the edges in [first, last) with one shift of the edges after them, calling
+			// on_erase(dst, count) for each destination that loses count of them.
+			// Returns: An iterator to the edge last pointed to.
+			template<typename Callback>
+			auto erase(const_iterator first, const_iterator last, Callback on_erase) -> const_iterator {
+				if (first == last) {
+					return last;
+				}
+				auto const first_group = static_cast<std::size_t>(first.group_ - groups_.data());
+				auto const last_group = static_cast<std::size_t>(last.group_ - groups_.data());
+				if constexpr (weightless) {
+					for (auto i = first_group; i < last_group; ++i) {
+						on_erase(groups_[i].dst, std::size_t{1});
+					}
+					groups_.erase(groups_.begin() + static_cast<std::ptrdiff_t>(first_group),
+					              groups_.begin() + static_cast<std::ptrdiff_t>(last_group));
+					return const_iterator(this, first_group, first.index_);
+				}
+				else {
+					// only the runs of first_group and last_group can be cut partway
+					auto const end_group = std::min(last_group + 1, groups_.size());
+					for (auto i = first_group; i < end_group; ++i) {
+						auto const lo = std::max(run_begin(i), first.index_);
+						auto const hi = std::min(groups_[i].end, last.index_);
+						if (lo < hi) {
+							on_erase(groups_[i].dst, hi - lo);
+						}
+					}
+
+					weights_.erase(weights_.begin() + static_cast<std::ptrdiff_t>(first.index_),
+					               weights_.begin() + static_cast<std::ptrdiff_t>(last.index_));
+					shift_ends(last_group, -static_cast<std::ptrdiff_t>(last.index_ - first.index_));
+					auto erase_from = first_group;
+					if (first_group != last_group && first.index_ != run_begin(first_group)) {
+						groups_[first_group].end = first.index_;
+						++erase_from;
+					}
+					groups_.erase(groups_.begin() + static_cast<std::ptrdiff_t>(erase_from),
+					              groups_.begin() + static_cast<std::ptrdiff_t>(last_group));
+					return const_iterator(this, erase_from, first.index_);
+				}
+			}
+
+			// Erases every edge to dst.
+			auto erase(node_handle dst) -> void {
+				auto const i = lower_bound(dst);
+				if (i == groups_.size() || groups_[i].dst != dst) {
+					return;
+				}
+				if constexpr (!weightless) {
+					auto const first = run_begin(i);
+					auto const last = groups_[i].end;
+					weights_.erase(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+					               weights_.begin() + static_cast<std::ptrdiff_t>(last));
+					shift_ends(i, -static_cast<std::ptrdiff_t>(last - first));
+				}
+				groups_.erase(groups_.begin() + static_cast<std::ptrdiff_t>(i));
+			}
+
+		private:
+			resource_vector<group> groups_;
+			[[no_unique_address]] weight_store weights_;
+
+			// Returns the index of the first group whose destination doesn't sort before dst.
+			[[nodiscard]] auto lower_bound(node_handle dst) const -> std::size_t {
+				auto const iter = std::lower_bound(groups_.begin(),
+				                                   groups_.end(),
+				                                   dst,
+				                                   [](group const& lhs, node_handle rhs) {
+					                                   return lhs.dst != rhs
+					                                          && value_of(lhs.dst) < value_of(rhs);
+				                                   });
+				return static_cast<std::size_t>(iter - groups_.begin());
+			}
+
+			[[nodiscard]] auto run_begin(std::size_t i) const noexcept -> std::size_t {
+				if constexpr (weightless) {
+					return i;
+				}
+				else {
+					return i == 0 ? 0 : groups_[i - 1].end;
+				}
+			}
+
+			[[nodiscard]] auto run_at(std::size_t i) const noexcept -> weight_run {
+				if constexpr (weightless) {
+					return std::span<E const>(&no_weight, 1);
+				}
+				else if constexpr (packed_weights) {
+					auto const first = weights_.begin();
+					return weight_run(first + static_cast<std::ptrdiff_t>(run_begin(i)),
+					                  first + static_cast<std::ptrdiff_t>(groups_[i].end));
+				}
+				else {
+					auto const first = run_begin(i);
+					return std::span<E const>(weights_.data() + first, groups_[i].end - first);
+				}
+			}
+
+			[[nodiscard]] auto weight_at(std::size_t index) const noexcept -> weight_reference {
+				if constexpr (weightless) {
+					return no_weight;
+				}
+				else {
+					return weights_[index];
+				}
+			}
+
+			// Moves the ends of the runs from the i-th onwards by delta.
+			auto shift_ends(std::size_t i, std::ptrdiff_t delta) noexcept -> void {
+				for (; i < groups_.size(); ++i) {
+					auto& end = groups_[i].end;
+					end = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(end) + delta);
+				}
+			}
+
+			static inline E const no_weight = E{};
+		};
+
+		// The nodes that have an edge into a node, each paired with how many such edges it has. Kept
+		// sorted by handle in one contiguous block, so lookups compare pointers only.
+		class source_index {
+		public:
+			using value_type = std::pair<node_handle, std::size_t>;
+			using const_iterator = typename resource_vector<value_type>::const_iterator;
+
+			explicit source_index(std::pmr::memory_resource* resource)
+			: sources_(resource) {}
+
+			[[nodiscard]] auto begin() const noexcept -> const_iterator {
+				return sources_.begin();
+			}
+
+			[[nodiscard]] auto end() const noexcept -> const_iterator {
+				return sources_.end();
+			}
+
+			// Returns: The number of edges from every source combined.
+			[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+				return edge_count_;
+			}
+
+			// Records count more edges from src.
+			auto add(node_handle src, std::size_t count = 1) -> void {
+				edge_count_ += count;
+				auto const iter = lower_bound(src);
+				if (iter != sources_.end() && iter->first == src) {
+					iter->second += count;
+					return;
+				}
+				sources_.emplace(iter, src, count);
+			}
+
+			// Forgets count edges from src, and src itself once it has no edges left.
+			auto remove(node_handle src, std::size_t count = 1) -> void {
+				edge_count_ -= count;
+				auto const iter = lower_bound(src);
+				if ((iter->second -= count) == 0) {
+					sources_.erase(iter);
+				}
+			}
+
+			// Forgets every edge from src.
+			auto erase(node_handle src) -> void {
+				auto const iter = lower_bound(src);
+				if (iter != sources_.end() && iter->first == src) {
+					edge_count_ -= iter->second;
+					sources_.erase(iter);
 				}
-				return lhs->second < rhs->second;
 			}
-			auto operator()(const edge_ptr& lhs, const edge& rhs) const -> bool {
-				if (lhs->first != rhs.first) {
-					return lhs->first < rhs.first;
+
+			// Adds the counts in sorted, which is ordered by handle and holds each handle at most
+			// once.
+			auto merge(std::span<value_type const> sorted) -> void {
+				auto merged = resource_vector<value_type>(sources_.get_allocator());
+				merged.reserve(sources_.size() + sorted.size());
+				auto iter = sources_.begin();
+				for (auto const& [src, count] : sorted) {
+					edge_count_ += count;
+					for (; iter != sources_.end() && std::less<>{}(iter->first, src); ++iter) {
+						merged.push_back(*iter);
+					}
+					if (iter != sources_.end() && iter->first == src) {
+						merged.emplace_back(src, iter->second + count);
+						++iter;
+						continue;
+					}
+					merged.emplace_back(src, count);
 				}
-				return lhs->second < rhs.second;
+				merged.insert(merged.end(), iter, sources_.end());
+				sources_ = std::move(merged);
 			}
-			auto operator()(const edge& lhs, const edge_ptr& rhs) const -> bool {
-				if (lhs.first != rhs->first) {
-					return lhs.first < rhs->first;
+
+		private:
+			resource_vector<value_type> sources_;
+			std::size_t edge_count_ = 0;
+
+			auto lower_bound(node_handle src) -> typename resource_vector<value_type>::iterator {
+				return std::lower_bound(sources_.begin(),
+				                        sources_.end(),
+				                        src,
+				                        [](value_type const& lhs, node_handle rhs) {
+					                        return std::less<>{}(lhs.first, rhs);
+				                        });
+			}
+		};
+
+		// The outgoing edges of a node, along with an index of every node that has an edge into it,
+		// so incoming edges are found without a full scan.
+		struct node_entry {
+			explicit node_entry(std::pmr::memory_resource* resource)
+			: edges{resource}
+			, incoming{resource} {}
+
+			edge_set edges;
+			source_index incoming;
+		};
+
+		using graph_container =
+		   std::map<N,
+		            node_entry,
+		            graph_map_comparator,
+		            resource_allocator<std::pair<N const, node_entry>>>;
+
+		using hasher = typename graph_traits<N>::hasher;
+
+		// An open-addressing hash index from node values to their place in graph_, used when
+		// graph_traits<N> names a hasher. Slots are probed linearly, and an erased slot is filled by
+		// shifting back the entries after it, so lookups never wade through tombstones. The table is
+		// at most three quarters full.
+		class hash_index {
+		public:
+			using iterator = typename graph_container::iterator;
+
+			explicit hash_index(std::pmr::memory_resource* resource) noexcept
+			: slots_(resource) {}
+
+			// Returns: The node equivalent to value, or end if there is none.
+			template<typename K>
+			[[nodiscard]] auto find(K const& value, iterator end) const -> iterator {
+				if (slots_.empty()) {
+					return end;
+				}
+				auto const tag = tag_of(value);
+				for (auto i = home_of(tag);; i = next(i)) {
+					auto const& entry = slots_[i];
+					if (entry.tag == 0) {
+						return end;
+					}
+					if (entry.tag == tag && entry.node->first == value) {
+						return entry.node;
+					}
 				}
-				return lhs.second < rhs->second;
 			}
-			auto operator()(N lhs, const edge_ptr& rhs) const -> bool {
-				return lhs < rhs->first;
+
+			auto insert(iterator node) -> void {
+				if (4 * (size_ + 1) > 3 * slots_.size()) {
+					rehash(std::max(2 * slots_.size(), std::size_t{16}));
+				}
+				place(slot{tag_of(node->first), node});
+				++size_;
 			}
-			auto operator()(const edge_ptr& lhs, N rhs) const -> bool {
-				return lhs->first < rhs;
+
+			auto erase(iterator node) -> void {
+				auto hole = home_of(tag_of(node->first));
+				while (slots_[hole].tag == 0 || slots_[hole].node != node) {
+					hole = next(hole);
+				}
+				for (auto i = next(hole); slots_[i].tag != 0; i = next(i)) {
+					// an entry may fill the hole if the hole lies between its home slot and its slot
+					if (distance(home_of(slots_[i].tag), i) >= distance(hole, i)) {
+						slots_[hole] = slots_[i];
+						hole = i;
+					}
+				}
+				slots_[hole] = slot{};
+				--size_;
+			}
+
+			auto reserve(std::size_t count) -> void {
+				auto capacity = std::size_t{16};
+				while (3 * capacity < 4 * count) {
+					capacity *= 2;
+				}
+				if (capacity > slots_.size()) {
+					rehash(capacity);
+				}
+			}
+
+			auto clear() noexcept -> void {
+				slots_.clear();
+				size_ = 0;
+			}
+
+		private:
+			// tag is the node's hash with the top bit set, so that 0 marks an empty slot
+			struct slot {
+				std::size_t tag = 0;
+				iterator node;
+			};
+
+			resource_vector<slot> slots_;
+			std::size_t size_ = 0;
+
+			template<typename K>
+			static auto tag_of(K const& value) -> std::size_t {
+				constexpr auto top_bit = std::size_t{1}
+				                         << (std::numeric_limits<std::size_t>::digits - 1);
+				return hasher{}(value) | top_bit;
+			}
+
+			// Fibonacci hashing spreads weak hashes, such as std::hash<int>, over the whole table.
+			[[nodiscard]] auto home_of(std::size_t tag) const -> std::size_t {
+				constexpr auto golden = std::size_t{0x9e3779b97f4a7c15};
+				auto const bits = std::bit_width(slots_.size() - 1);
+				return (tag * golden) >> (std::numeric_limits<std::size_t>::digits - bits);
+			}
+
+			[[nodiscard]] auto next(std::size_t i) const -> std::size_t {
+				return (i + 1) & (slots_.size() - 1);
+			}
+
+			[[nodiscard]] auto distance(std::size_t from, std::size_t to) const -> std::size_t {
+				return (to - from) & (slots_.size() - 1);
+			}
+
+			auto place(slot const& entry) -> void {
+				auto i = home_of(entry.tag);
+				while (slots_[i].tag != 0) {
+					i = next(i);
+				}
+				slots_[i] = entry;
+			}
+
+			auto rehash(std::size_t capacity) -> void {
+				auto old = resource_vector<slot>(capacity, slots_.get_allocator());
+				std::swap(old, slots_);
+				for (auto const& entry : old) {
+					if (entry.tag != 0) {
+						place(entry);
+					}
+				}
 			}
 		};
 
-		using edge_set = std::set<edge_ptr, edge_set_comparator>;
-		using graph_container = std::map<node_ptr, edge_set, graph_map_comparator>;
+		// Stands in for hash_index when there is no hasher.
+		struct no_index {
+			explicit no_index(std::pmr::memory_resource*) noexcept {}
+			auto insert(typename graph_container::iterator) -> void {}
+			auto erase(typename graph_container::iterator) -> void {}
+			auto reserve(std::size_t) -> void {}
+			auto clear() noexcept -> void {}
+		};
+
+		using node_index = std::conditional_t<std::is_void_v<hasher>, no_index, hash_index>;
+
 		graph_container graph_;
+		[[no_unique_address]] node_index index_ = node_index(std::pmr::get_default_resource());
+		std::size_t edge_count_ = 0;
+
+		// Keys that can be compared with the stored nodes without being converted to N first.
+		// Arithmetic keys that convert to N, and keys that convert to arithmetic N, are converted,
+		// so that they are ordered as N rather than by the usual arithmetic conversions.
+		template<typename K>
+		static constexpr auto is_comparable_key =
+		   std::is_same_v<K, N>
+		   || (requires(K const& key, N const& node) {
+			      { key < node } -> std::convertible_to<bool>;
+			      { node < key } -> std::convertible_to<bool>;
+		      }
+		      && !(std::is_convertible_v<K const&, N>
+		           && (std::is_arithmetic_v<K> || std::is_arithmetic_v<N>)));
+
+		// Keys the hash index can find: N itself, or anything a transparent hasher accepts.
+		template<typename K>
+		static constexpr auto is_hashable_key =
+		   std::is_same_v<K, N>
+		   || requires(K const& key, N const& node) {
+			      typename hasher::is_transparent;
+			      { hasher{}(key) } -> std::convertible_to<std::size_t>;
+			      { node == key } -> std::convertible_to<bool>;
+		      };
+
+		// Returns the node equivalent to key, or graph_.end() if there is none. A key the hasher
+		// doesn't accept is searched for in graph_ rather than converted to N for the index, so a
+		// lookup never allocates.
+		template<typename K>
+		auto lookup(K const& key) -> typename graph_container::iterator {
+			if constexpr (!is_comparable_key<K>) {
+				// the conversion is the one node_key asks for, narrowing or not
+				auto const value = static_cast<N>(key);
+				return lookup(value);
+			}
+			else if constexpr (std::is_void_v<hasher> || !is_hashable_key<K>) {
+				return graph_.find(key);
+			}
+			else {
+				return index_.find(key, graph_.end());
+			}
+		}
+
+		// Looking a node up never modifies the graph, so the const overload can share the other.
+		template<typename K>
+		auto lookup(K const& key) const -> typename graph_container::const_iterator {
+			return const_cast<graph&>(*this).lookup(key);
+		}
+
+		// Returns the handle for the node graph_ holds at iter. Handles are only written through by
+		// non-const members, so dropping the const from a const_iterator here is safe.
+		static auto handle_of(typename graph_container::const_iterator iter) -> node_handle {
+			return const_cast<node_handle>(&*iter);
+		}
+
+		static auto value_of(node_handle node) -> N const& {
+			return node->first;
+		}
+
+		// Collects the text written by operator<< and hands it to the stream in large blocks. While
+		// the stream is formatting with its defaults, numbers are converted with std::to_chars and
+		// strings are copied as they are, which yields exactly what operator<< would; anything else
+		// goes through operator<<.
+		class output_buffer {
+		public:
+			explicit output_buffer(std::ostream& os)
+			: os_{&os}
+			, direct_{os.width() == 0
+			          && (os.flags() & ~(std::ios::skipws | std::ios::unitbuf)) == std::ios::dec
+			          && os.getloc() == std::locale::classic()} {
+				if (direct_) {
+					text_.reserve(flush_size);
+				}
+			}
+
+			template<typename T>
+			auto put(T const& value) -> void {
+				if (direct_ && append(value)) {
+					if (text_.size() >= flush_size) {
+						flush();
+					}
+					return;
+				}
+				flush();
+				*os_ << value;
+			}
+
+			// Writes the line operator<< prints for an edge to dst with weight weight.
+			template<typename T>
+			auto put_edge(T const& dst, E const& weight) -> void {
+				put("  ");
+				put(dst);
+				if constexpr (!omits_weight<E>) {
+					put(" | ");
+					put(weight);
+				}
+				put("\n");
+			}
+
+			auto flush() -> void {
+				if (!text_.empty()) {
+					os_->write(text_.data(), static_cast<std::streamsize>(text_.size()));
+					text_.clear();
+				}
+			}
+
+		private:
+			static constexpr auto flush_size = std::size_t{1} << 16;
+
+			// Characters and bools are arithmetic, but are not printed as numbers.
+			template<typename T>
+			static constexpr auto is_number =
+			   std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>
+			   && !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>
+			   && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t>
+			   && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+			std::ostream* os_;
+			bool direct_;
+			std::string text_;
+
+			// Appends value as operator<< would print it with the default format flags.
+			// Returns: false, leaving the text unchanged, if value can't be converted here.
+			template<typename T>
+			auto append(T const& value) -> bool {
+				if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+					text_.append(std::string_view(value));
+					return true;
+				}
+				else if constexpr (is_number<T>) {
+					auto digits = std::array<char, 64>{};
+					auto const [end, ec] = [&] {
+						if constexpr (std::is_integral_v<T>) {
+							return std::to_chars(digits.data(), digits.data() + digits.size(), value);
+						}
+						else {
+							// the default float field is printf's %g at the stream's precision
+							return std::to_chars(digits.data(),
+							                     digits.data() + digits.size(),
+							                     value,
+							                     std::chars_format::general,
+							                     static_cast<int>(os_->precision()));
+						}
+					}();
+					if (ec != std::errc{}) {
+						return false;
+					}
+					text_.append(digits.data(), end);
+					return true;
+				}
+				else {
+					return false;
+				}
+			}
+		};
+
+		// Returns the run of weights of the edges from the node at src_iter to the node at dst_iter.
+		static auto edge_weights(typename graph_container::const_iterator src_iter,
+		                         typename graph_container::const_iterator dst_iter)
+		   -> weight_run {
+			return src_iter->second.edges.run(handle_of(dst_iter));
+		}
+
+		// Adds src → dst with weight weight, if, and only if, it is not already stored.
+		auto emplace_edge(node_handle src, node_handle dst, E const& weight) -> bool {
+			if (!src->second.edges.emplace(dst, weight)) {
+				return false;
+			}
+			link(src, dst);
+			return true;
+		}
+
+		// Adds value if it isn't already a node, with a single search.
+		// Returns: The node equivalent to value, and whether it was added.
+		auto emplace_node(N const& value) -> std::pair<typename graph_container::iterator, bool> {
+			auto const hint = graph_.lower_bound(value);
+			if (hint != graph_.end() && !(value < hint->first)) {
+				return {hint, false};
+			}
+			auto const node = graph_.emplace_hint(hint, value, node_entry(resource()));
+			index_.insert(node);
+			return {node, true};
+		}
+
+		// Moves every edge incident to the node at old_iter over to the node at new_iter, then
+		// erases the former.
+		auto merge_node(typename graph_container::iterator old_iter,
+		                typename graph_container::iterator new_iter) -> void {
+			auto const old_node = handle_of(old_iter);
+			auto const new_node = handle_of(new_iter);
+
+			// collect the replacement edges first, since inserting them may touch the edge sets being
+			// walked here
+			auto replacements = std::vector<std::tuple<node_handle, node_handle, E>>{};
+			for (auto const& [dst, weight] : old_node->second.edges) {
+				replacements.emplace_back(new_node, dst != old_node ? dst : new_node, weight);
+			}
+			for (auto const& [src, _] : old_node->second.incoming) {
+				if (src == old_node) {
+					continue;
+				}
+				for (auto const& weight : src->second.edges.run(old_node)) {
+					replacements.emplace_back(src, new_node, weight);
+				}
+			}
+
+			for (auto const& [from, to, weight] : replacements) {
+				emplace_edge(from, to, weight);
+			}
+			erase_entry(old_iter);
+		}
+
+		// Erases the node at node_iter, along with its incoming and outgoing edges.
+		auto erase_entry(typename graph_container::iterator node_iter) -> void {
+			auto const node = handle_of(node_iter);
+			edge_count_ -= node->second.edges.size() + node->second.incoming.edge_count();
+			for (auto const& [src, count] : node->second.incoming) {
+				if (src != node) {
+					src->second.edges.erase(node);
+				}
+				else {
+					// self-loops were counted among the outgoing edges as well
+					edge_count_ += count;
+				}
+			}
+			for (auto const& group : node->second.edges.groups()) {
+				if (group.dst != node) {
+					group.dst->second.incoming.erase(node);
+				}
+			}
+
+			index_.erase(node_iter);
+			graph_.erase(node_iter);
+		}
+
+		// Adds value if it isn't already a node. Takes amortised constant time when value sorts after
+		// every stored node, so sorted input is loaded in linear time.
+		auto append_node(N const& value) -> void {
+			if (!graph_.empty() && !(std::prev(graph_.end())->first < value)) {
+				insert_node(value);
+				return;
+			}
+			index_.insert(
+			   graph_.emplace_hint(graph_.end(), value, node_entry(resource())));
+		}
+
+		// Returns the edges in [first, last), sorted by src, dst, then weight, without duplicates.
+		template<typename InputIt>
+		static auto sorted_batch(InputIt first, InputIt last) -> std::vector<value_type> {
+			auto batch = std::vector<value_type>(first, last);
+			auto const key = [](value_type const& v) { return std::tie(v.from, v.to, v.weight); };
+			auto const less = [&key](value_type const& lhs, value_type const& rhs) {
+				return key(lhs) < key(rhs);
+			};
+			if (!std::is_sorted(batch.begin(), batch.end(), less)) {
+				std::sort(batch.begin(), batch.end(), less);
+			}
+			auto const equal = [&key](value_type const& lhs, value_type const& rhs) {
+				return key(lhs) == key(rhs);
+			};
+			batch.erase(std::unique(batch.begin(), batch.end(), equal), batch.end());
+			return batch;
+		}
+
+		// Adds edges[i] to the outgoing edges of sources[i], for each i. Both are ordered by source,
+		// then by edge_less.
+		// Returns: The number of edges added.
+		auto insert_sorted_edges(std::vector<node_handle> const& sources,
+		                         std::vector<edge> const& edges) -> std::size_t {
+			// (dst, src) for every edge added, so the incoming indices are built in one pass at the
+			// end
+			auto links = std::vector<std::pair<node_handle, node_handle>>{};
+			links.reserve(edges.size());
+			for (auto run = std::size_t{0}; run < edges.size();) {
+				auto const src = sources[run];
+				auto run_end = run;
+				for (; run_end < edges.size() && sources[run_end] == src; ++run_end) {
+				}
+				auto const on_insert = [src, &links](edge const& value) {
+					links.emplace_back(value.first, src);
+				};
+				src->second.edges.merge(std::span(edges).subspan(run, run_end - run), on_insert);
+				run = run_end;
+			}
+
+			std::sort(links.begin(), links.end(), std::less<>{});
+			auto counts = std::vector<typename source_index::value_type>{};
+			for (auto run = links.begin(); run != links.end();) {
+				auto const dst = run->first;
+				counts.clear();
+				for (; run != links.end() && run->first == dst; ++run) {
+					if (counts.empty() || counts.back().first != run->second) {
+						counts.emplace_back(run->second, 0);
+					}
+					++counts.back().second;
+				}
+				dst->second.incoming.merge(counts);
+			}
+			edge_count_ += links.size();
+			return links.size();
+		}
+
+		// Records a new src → dst edge in dst's incoming index and the edge count.
+		auto link(node_handle src, node_handle dst) -> void {
+			dst->second.incoming.add(src);
+			++edge_count_;
+		}
+
+		// Removes one src → dst edge from dst's incoming index and the edge count.
+		auto unlink(node_handle src, node_handle dst) -> void {
+			dst->second.incoming.remove(src);
+			--edge_count_;
+		}
 	};
 
 	template<typename N, typename E>
@@ -440,7 +1789,8 @@ namespace gdwg {
 
 		// Returns the current from, to, and weight.
 		auto operator*() const -> reference {
-			return value_type{*graph_iter_->first, (*edge_iter_)->first, (*edge_iter_)->second};
+			auto const& [dst, weight] = *edge_iter_;
+			return value_type{graph_iter_->first, value_of(dst), weight};
 		};
 
 		// auto operator->() -> pointer not required
@@ -451,17 +1801,18 @@ namespace gdwg {
 
 		// Advances *this to the next element in the iterable list.
 		auto operator++() -> iterator& {
-			if (edge_iter_ != graph_iter_->second.end()) {
+			if (edge_iter_ != graph_iter_->second.edges.end()) {
 				++edge_iter_;
 			}
 
-			if (edge_iter_ == graph_iter_->second.end()) {
+			if (edge_iter_ == graph_iter_->second.edges.end()) {
 				++graph_iter_;
 				if (graph_iter_ != graph_iter_end_) {
-					for (; graph_iter_ != graph_iter_end_ && graph_iter_->second.empty(); ++graph_iter_) {
+					for (; graph_iter_ != graph_iter_end_ && graph_iter_->second.edges.empty();
+					     ++graph_iter_) {
 					}
 					if (graph_iter_ != graph_iter_end_) {
-						edge_iter_ = graph_iter_->second.begin();
+						edge_iter_ = graph_iter_->second.edges.begin();
 					}
 				}
 			}
@@ -477,16 +1828,17 @@ namespace gdwg {
 
 		// Advances *this to the previous element in the iterable list.
 		auto operator--() -> iterator& {
-			while (graph_iter_ == graph_iter_end_ || graph_iter_->second.empty()) {
+			while (graph_iter_ == graph_iter_end_ || graph_iter_->second.edges.empty()) {
 				--graph_iter_;
-				edge_iter_ = graph_iter_->second.end();
+				edge_iter_ = graph_iter_->second.edges.end();
 			}
 
-			if (edge_iter_ == graph_iter_->second.begin()) {
+			if (edge_iter_ == graph_iter_->second.edges.begin()) {
 				--graph_iter_;
-				for (; graph_iter_ == graph_iter_end_ || graph_iter_->second.empty(); --graph_iter_) {
+				for (; graph_iter_ == graph_iter_end_ || graph_iter_->second.edges.empty();
+				     --graph_iter_) {
 				}
-				edge_iter_ = graph_iter_->second.end();
+				edge_iter_ = graph_iter_->second.edges.end();
 			}
 
 			--edge_iter_;
@@ -524,36 +1876,103 @@ namespace gdwg {
 		// Iterator constructor [gdwg.iterator.ctor]
 		// --------------------------------------------
 
-		// Constructs an iterator to a specific element in the graph.
-		explicit iterator(map_iter graph_iter_begin, map_iter graph_iter_end, edges_iter edge_iter)
+		// Constructs an iterator to the first edge of the first node from graph_iter_begin onwards
+		// that has any edges.
+		explicit iterator(map_iter graph_iter_begin, map_iter graph_iter_end)
 		: graph_iter_{graph_iter_begin}
-		, graph_iter_end_{graph_iter_end}
-		, edge_iter_{edge_iter} {
-			for (; graph_iter_ != graph_iter_end_ && graph_iter_->second.empty(); ++graph_iter_) {
+		, graph_iter_end_{graph_iter_end} {
+			for (; graph_iter_ != graph_iter_end_ && graph_iter_->second.edges.empty();
+			     ++graph_iter_) {
 			}
 			if (graph_iter_ != graph_iter_end_) {
-				edge_iter_ = graph_iter_->second.begin();
+				edge_iter_ = graph_iter_->second.edges.begin();
 			}
 		};
 
+		// Constructs an iterator to a specific element in the graph.
+		explicit iterator(map_iter graph_iter, map_iter graph_iter_end, edges_iter edge_iter)
+		: graph_iter_{graph_iter}
+		, graph_iter_end_{graph_iter_end}
+		, edge_iter_{edge_iter} {};
+
+		friend class graph;
+	};
+
+	// Walks the distinct destinations of a node's outgoing edges. Each destination is stored once,
+	// however many edges lead to it, so this is a walk over consecutive groups.
+	template<typename N, typename E>
+	class graph<N, E>::neighbour_iterator {
+	public:
+		using value_type = N;
+		using reference = N const&;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		neighbour_iterator() = default;
+
+		auto operator*() const -> reference {
+			return value_of(group_->dst);
+		}
+
+		auto operator++() -> neighbour_iterator& {
+			++group_;
+			return *this;
+		}
+
+		auto operator++(int) -> neighbour_iterator {
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		auto operator==(neighbour_iterator const& other) const -> bool {
+			return group_ == other.group_;
+		}
+
+	private:
+		using group = typename edge_set::group;
+
+		group const* group_ = nullptr;
+
+		explicit neighbour_iterator(group const* first)
+		: group_{first} {}
+
 		friend class graph;
 	};
 
 	template<typename N, typename E>
 	auto graph<N, E>::erase_edge(iterator i) -> iterator {
-		auto next = i++;
-		auto const& edge_iter = next.edge_iter_;
-		auto const& src_node = next.graph_iter_->first;
-		auto& edge_set = graph_.find(src_node)->second;
-		edge_set.erase(edge_iter);
-		return i;
+		auto const src_node = handle_of(i.graph_iter_);
+		auto& edges = src_node->second.edges;
+		unlink(src_node, (*i.edge_iter_).first);
+
+		// the edges after the erased one shift down into its place
+		auto const next = edges.erase(i.edge_iter_);
+		if (next != edges.end()) {
+			return iterator(i.graph_iter_, i.graph_iter_end_, next);
+		}
+		return iterator(std::next(i.graph_iter_), i.graph_iter_end_);
 	};
 
 	template<typename N, typename E>
 	auto graph<N, E>::erase_edge(iterator i, iterator s) -> iterator {
-		for (; i != s; i = erase_edge(i)) {
-		};
-		return i;
+		// each source's edges in [i, s) are contiguous, so they go in one erase per source; only
+		// the source of s keeps edges after its run
+		for (auto node = i.graph_iter_; node != i.graph_iter_end_; ++node) {
+			auto const src = handle_of(node);
+			auto const on_erase = [this, src](node_handle dst, std::size_t count) {
+				dst->second.incoming.remove(src, count);
+				edge_count_ -= count;
+			};
+			auto& edges = src->second.edges;
+			auto const first = node == i.graph_iter_ ? i.edge_iter_ : edges.begin();
+			if (node == s.graph_iter_) {
+				auto const next = edges.erase(first, s.edge_iter_, on_erase);
+				return iterator(node, i.graph_iter_end_, next);
+			}
+			edges.erase(first, edges.end(), on_erase);
+		}
+		return end();
 	}
 
 } // namespace gdwg
@@ -0,0 +1,448 @@
+#ifndef GDWG_GRAPH_IO_HPP
+#define GDWG_GRAPH_IO_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// The text formats read_graph() understands.
+	enum class graph_format {
+		// The output of operator<<: a "src (" line for each node, followed by a "  dst | weight"
+		// line for each of its outgoing edges and a ")" line. Nodes and weights take up the rest of
+		// their line, so they may hold spaces but not newlines. Edges of a graph whose weights are
+		// omitted, such as those of graph<N, unweighted>, are "  dst" lines.
+		dump,
+		// A "src dst weight" line for each edge, with the fields separated by whitespace, so no
+		// field may hold any. Blank lines and lines starting with '#' are skipped. Only nodes that
+		// are the src or dst of an edge can be written this way. Edges of a graph whose weights are
+		// omitted are "src dst" lines.
+		edge_list,
+	};
+
+	namespace detail {
+		// Input is read in rounds of up to this many bytes per thread, so memory use is bounded by
+		// the round rather than by the input.
+		constexpr auto chunk_bytes = std::size_t{1} << 20;
+
+		// The arithmetic types operator<< writes as a character rather than as a number.
+		template<typename T>
+		constexpr auto is_character = std::is_same_v<T, char> || std::is_same_v<T, signed char>
+		                              || std::is_same_v<T, unsigned char>;
+
+		// Returns: The value written as text, or nullopt if text isn't exactly one T. Characters
+		// are the single character of text, other arithmetic types are parsed with
+		// std::from_chars, types constructible from a string_view are built from text directly,
+		// and anything else is extracted with operator>>.
+		template<typename T>
+		auto parse_value(std::string_view text) -> std::optional<T> {
+			if constexpr (is_character<T>) {
+				if (text.size() != 1) {
+					return std::nullopt;
+				}
+				return static_cast<T>(text.front());
+			}
+			else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+				auto value = T{};
+				auto const* const last = text.data() + text.size();
+				auto const [end, ec] = std::from_chars(text.data(), last, value);
+				if (ec != std::errc{} || end != last) {
+					return std::nullopt;
+				}
+				return value;
+			}
+			else if constexpr (std::is_constructible_v<T, std::string_view>) {
+				return T(text);
+			}
+			else {
+				auto is = std::istringstream(std::string(text));
+				auto value = T{};
+				if (!(is >> value) || !(is >> std::ws).eof()) {
+					return std::nullopt;
+				}
+				return value;
+			}
+		}
+
+		// What a thread made of one piece of a round. A piece may start partway through a block of
+		// a dump, so edges and a ")" seen before its first "src (" line belong to whichever block
+		// the pieces before it left open; they are resolved when the pieces are merged in order.
+		// An indented line ending in " (" seen there may be either an edge of that block or a
+		// header, so it is read as a header and the piece is marked ambiguous, to be parsed again
+		// if a block turns out to be open.
+		template<typename N, typename E>
+		struct parsed_piece {
+			std::string_view text;
+			// Whether the piece was parsed knowing the block left open before it, so nothing in it
+			// is carried.
+			bool inherits = false;
+			bool ambiguous = false;
+			std::vector<N> nodes;
+			std::vector<typename graph<N, E>::value_type> edges;
+			std::vector<std::pair<N, E>> carried_edges;
+			bool closes_carried = false;
+			bool has_header = false;
+			std::size_t first_header_line = 0;
+			// The src of a block started in this piece and still open at its end.
+			std::optional<N> open;
+			std::size_t lines = 0;
+			// The line, counted from the start of the piece, that could not be parsed, or 0.
+			std::size_t error_line = 0;
+		};
+
+		// Returns: The weight written as text, or nullopt if text isn't exactly one E. A weight that
+		// is omitted has no field of its own, so it is never parsed.
+		template<typename E>
+		auto parse_weight(std::string_view text) -> std::optional<E> {
+			if constexpr (omits_weight<E>) {
+				return E{};
+			}
+			else {
+				return parse_value<E>(text);
+			}
+		}
+
+		template<typename N, typename E>
+		auto parse_dump_line(std::string_view line, parsed_piece<N, E>& piece) -> bool {
+			auto const before_header = !piece.inherits && !piece.has_header && !piece.closes_carried;
+			// outside a block, a line is a header first, since a node may itself start with the
+			// indent of an edge line
+			if (line.ends_with(" (") && !piece.open) {
+				if (auto src = parse_value<N>(line.substr(0, line.size() - 2))) {
+					piece.ambiguous = piece.ambiguous || (before_header && line.starts_with("  "));
+					if (!piece.has_header) {
+						piece.has_header = true;
+						piece.first_header_line = piece.lines;
+					}
+					piece.nodes.push_back(*src);
+					piece.open = std::move(src);
+					return true;
+				}
+			}
+
+			if (line.starts_with("  ")) {
+				auto separator = line.size();
+				if constexpr (!omits_weight<E>) {
+					separator = line.rfind(" | ");
+					if (separator == std::string_view::npos || separator < 2) {
+						return false;
+					}
+				}
+				auto dst = parse_value<N>(line.substr(2, separator - 2));
+				auto weight = parse_weight<E>(line.substr(std::min(separator + 3, line.size())));
+				if (!dst || !weight) {
+					return false;
+				}
+				piece.nodes.push_back(*dst);
+				if (piece.open) {
+					piece.edges.push_back({*piece.open, std::move(*dst), std::move(*weight)});
+				}
+				else if (before_header) {
+					piece.carried_edges.emplace_back(std::move(*dst), std::move(*weight));
+				}
+				else {
+					return false;
+				}
+				return true;
+			}
+
+			if (line == ")") {
+				if (piece.open) {
+					piece.open.reset();
+				}
+				else if (before_header) {
+					piece.closes_carried = true;
+				}
+				else {
+					return false;
+				}
+				return true;
+			}
+
+			return false;
+		}
+
+		template<typename N, typename E>
+		auto parse_edge_list_line(std::string_view line, parsed_piece<N, E>& piece) -> bool {
+			constexpr auto whitespace = std::string_view(" \t\r");
+			auto const first = line.find_first_not_of(whitespace);
+			if (first == std::string_view::npos || line[first] == '#') {
+				return true;
+			}
+
+			auto fields = std::array<std::string_view, omits_weight<E> ? 2 : 3>{};
+			auto count = std::size_t{0};
+			for (auto start = first; start != std::string_view::npos;
+			     start = line.find_first_not_of(whitespace, start)) {
+				if (count == fields.size()) {
+					return false;
+				}
+				auto const end = std::min(line.find_first_of(whitespace, start), line.size());
+				fields[count++] = line.substr(start, end - start);
+				start = end;
+			}
+
+			if (count != fields.size()) {
+				return false;
+			}
+			auto src = parse_value<N>(fields[0]);
+			auto dst = parse_value<N>(fields[1]);
+			auto weight = parse_weight<E>(fields.back());
+			if (!src || !dst || !weight) {
+				return false;
+			}
+			piece.nodes.push_back(*src);
+			piece.nodes.push_back(*dst);
+			piece.edges.push_back({std::move(*src), std::move(*dst), std::move(*weight)});
+			return true;
+		}
+
+		// Parses text, a sequence of whole lines, stopping at the first line in error. If open is
+		// set, text starts inside the block of a dump that open is the src of.
+		template<typename N, typename E>
+		auto parse_piece(std::string_view text,
+		                 graph_format format,
+		                 std::optional<N> const& open = std::nullopt) -> parsed_piece<N, E> {
+			auto piece = parsed_piece<N, E>{};
+			piece.text = text;
+			piece.inherits = open.has_value();
+			piece.open = open;
+			while (!text.empty()) {
+				auto const eol = std::min(text.find('\n'), text.size());
+				auto const line = text.substr(0, eol);
+				text.remove_prefix(std::min(eol + 1, text.size()));
+				++piece.lines;
+				auto const parsed = format == graph_format::dump ? parse_dump_line(line, piece)
+				                                                 : parse_edge_list_line(line, piece);
+				if (!parsed) {
+					piece.error_line = piece.lines;
+					break;
+				}
+			}
+			return piece;
+		}
+
+		// Splits text into up to threads pieces of whole lines, and parses them at once. The first
+		// piece starts inside the block that open is the src of, if it is set.
+		template<typename N, typename E>
+		auto parse_pieces(std::string_view text,
+		                  graph_format format,
+		                  std::size_t threads,
+		                  std::optional<N> const& open) -> std::vector<parsed_piece<N, E>> {
+			auto bounds = std::vector<std::size_t>{0};
+			for (auto t = std::size_t{1}; t < threads; ++t) {
+				auto const eol = text.find('\n', std::max(text.size() * t / threads, bounds.back()));
+				if (eol == std::string_view::npos) {
+					break;
+				}
+				bounds.push_back(eol + 1);
+			}
+			if (bounds.back() != text.size()) {
+				bounds.push_back(text.size());
+			}
+
+			auto pieces = std::vector<parsed_piece<N, E>>(bounds.size() - 1);
+			auto const parse = [&](std::size_t i) {
+				auto const piece = text.substr(bounds[i], bounds[i + 1] - bounds[i]);
+				pieces[i] = i == 0 ? parse_piece<N, E>(piece, format, open)
+				                   : parse_piece<N, E>(piece, format);
+			};
+			{
+				auto workers = std::vector<std::jthread>{};
+				workers.reserve(pieces.size());
+				for (auto i = std::size_t{1}; i < pieces.size(); ++i) {
+					workers.emplace_back(parse, i);
+				}
+				if (!pieces.empty()) {
+					parse(0);
+				}
+			}
+			return pieces;
+		}
+	} // namespace detail
+
+	// Reads a graph written in format from is, until the end of the stream. The input is read in
+	// rounds of bounded size, each round's lines are split between up to threads threads to be
+	// parsed, and the parsed nodes and edges are then bulk inserted, so memory use depends on the
+	// round size rather than the size of the input.
+	// Returns: The graph, allocated from resource.
+	// Complexity: O(k log (k)) for k lines in a dump. An edge list in no particular order also
+	// costs O(d) per round for each source it touches, where d is that source's edges so far.
+	template<typename N, typename E>
+	[[nodiscard]] auto
+	read_graph(std::istream& is,
+	           graph_format format = graph_format::dump,
+	           std::size_t threads = 1,
+	           std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+	   -> graph<N, E> {
+		if (!is) {
+			throw std::runtime_error("Cannot call gdwg::read_graph on a stream that can't be read");
+		}
+		threads = std::max(threads, std::size_t{1});
+		auto g = graph<N, E>(resource);
+		auto lines = std::size_t{0};
+		auto const malformed = [&lines](std::size_t line) {
+			return std::runtime_error("Cannot call gdwg::read_graph on malformed input at line "
+			                          + std::to_string(lines + line));
+		};
+
+		// the src of the block the previous rounds left open, in a dump
+		auto open = std::optional<N>{};
+		auto buffer = std::string{};
+		auto done = false;
+		while (!done) {
+			auto const kept = buffer.size();
+			buffer.resize(kept + threads * detail::chunk_bytes);
+			is.read(buffer.data() + kept, static_cast<std::streamsize>(threads * detail::chunk_bytes));
+			buffer.resize(kept + static_cast<std::size_t>(is.gcount()));
+			if (is.bad()) {
+				throw std::runtime_error("Cannot call gdwg::read_graph on a stream that can't be "
+				                         "read");
+			}
+			// only a read cut short by the end of the stream fails without setting badbit
+			done = !is;
+
+			// a line cut off by the end of the round is kept for the next one
+			auto const complete = done ? buffer.size() : buffer.rfind('\n') + 1;
+			auto nodes = std::vector<N>{};
+			auto edges = std::vector<typename graph<N, E>::value_type>{};
+			auto const text = std::string_view(buffer).substr(0, complete);
+			for (auto& piece : detail::parse_pieces<N, E>(text, format, threads, open)) {
+				if (piece.ambiguous && open) {
+					// what was read as a header at the start of the piece is an edge of the open
+					// block, so the piece is read again from inside it
+					piece = detail::parse_piece<N, E>(piece.text, format, open);
+				}
+				if (piece.inherits) {
+					open = std::move(piece.open);
+				}
+				else {
+					if (!piece.carried_edges.empty() && !open) {
+						throw malformed(1);
+					}
+					for (auto& [dst, weight] : piece.carried_edges) {
+						edges.push_back({*open, std::move(dst), std::move(weight)});
+					}
+					if (piece.closes_carried) {
+						if (!open) {
+							throw malformed(piece.carried_edges.size() + 1);
+						}
+						open.reset();
+					}
+					if (piece.has_header) {
+						if (open) {
+							throw malformed(piece.first_header_line);
+						}
+						open = std::move(piece.open);
+					}
+				}
+				if (piece.error_line != 0) {
+					throw malformed(piece.error_line);
+				}
+
+				nodes.insert(nodes.end(),
+				             std::make_move_iterator(piece.nodes.begin()),
+				             std::make_move_iterator(piece.nodes.end()));
+				edges.insert(edges.end(),
+				             std::make_move_iterator(piece.edges.begin()),
+				             std::make_move_iterator(piece.edges.end()));
+				lines += piece.lines;
+			}
+			buffer.erase(0, complete);
+
+			std::sort(nodes.begin(), nodes.end());
+			nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+			for (auto const& node : nodes) {
+				g.insert_node(node);
+			}
+			g.insert_edges(edges.begin(), edges.end());
+		}
+
+		if (open) {
+			throw malformed(0);
+		}
+		// running into the end of the stream is how reading stops, not a failure
+		is.clear(is.rdstate() & ~std::ios::failbit);
+		return g;
+	}
+
+	// Reads a graph written in format from the file at path.
+	// Returns: The graph, allocated from resource.
+	// Complexity: The same as reading it from a stream.
+	template<typename N, typename E>
+	[[nodiscard]] auto
+	read_graph(std::filesystem::path const& path,
+	           graph_format format = graph_format::dump,
+	           std::size_t threads = std::thread::hardware_concurrency(),
+	           std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+	   -> graph<N, E> {
+		auto is = std::ifstream(path, std::ios::binary);
+		if (!is) {
+			throw std::runtime_error("Cannot call gdwg::read_graph on a file that can't be opened");
+		}
+		return read_graph<N, E>(is, format, threads, resource);
+	}
+
+	// Writes every edge of g to os as an edge list, in the order g iterates over them.
+	// Throws: std::runtime_error if a node or weight is written as empty text or as text holding
+	// whitespace, or if a src is written starting with '#', since reading it back would split or
+	// skip it. Edges before it have already been written.
+	// Complexity: O(e), where e is the number of stored edges.
+	template<typename N, typename E>
+	auto write_edge_list(graph<N, E> const& g, std::ostream& os) -> void {
+		auto field = std::ostringstream{};
+		field.copyfmt(os);
+		auto const write_field = [&field, &os](auto const& value, bool first) {
+			field.str({});
+			field << value;
+			auto const text = field.view();
+			if (text.empty() || text.find_first_of(" \t\r\n") != std::string_view::npos
+			    || (first && text.front() == '#')) {
+				throw std::runtime_error("Cannot call gdwg::write_edge_list on a graph whose nodes or "
+				                         "weights can't be written as single fields");
+			}
+			os << text;
+		};
+		for (auto const& [from, to, weight] : g) {
+			write_field(from, true);
+			os << ' ';
+			write_field(to, false);
+			if constexpr (!omits_weight<E>) {
+				os << ' ';
+				write_field(weight, false);
+			}
+			os << '\n';
+		}
+	}
+
+	// Replaces g with the graph dumped by operator<< to the rest of is. If the input is malformed,
+	// g is left unchanged and failbit is set on is.
+	template<typename N, typename E>
+	auto operator>>(std::istream& is, graph<N, E>& g) -> std::istream& {
+		try {
+			g = read_graph<N, E>(is, graph_format::dump, 1, g.resource());
+		} catch (std::runtime_error const&) {
+			is.setstate(std::ios::failbit);
+		}
+		return is;
+	}
+} // namespace gdwg
+
+#endif // GDWG_GRAPH_IO_HPP
@@ -0,0 +1,593 @@
+#ifndef GDWG_MATRIX_VIEW_HPP
+#define GDWG_MATRIX_VIEW_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace gdwg {
+	// A read-only snapshot of a graph as an adjacency bit matrix, for small graphs that are close to
+	// complete. Nodes are kept sorted in one array, and bit j of row i is set when there is an edge
+	// from the i-th node to the j-th, so testing for an edge is a single bit test once both nodes
+	// are found. The matrix is also kept transposed, so that incoming edges are just as cheap, and
+	// neighbourhood intersections are counted a word at a time with std::popcount.
+	//
+	// Weights are stored once per edge, ordered by source, destination, and then weight, which is
+	// also the row-major order of the set bits. The weights of the p-th set bit start at
+	// pair_offsets[p], and when no two edges share a source and destination the offsets are left
+	// out, since the weights of the p-th set bit are then just the p-th weight. The rank of a bit is
+	// found in constant time from the rank of the word holding it, which is kept for every word.
+	//
+	// The matrices take n² / 4 bytes whatever the number of edges, and the word ranks another
+	// n² / 16, so the snapshot is only built for graphs of at most max_nodes nodes, where they take
+	// 20 MiB.
+	//
+	// Lookups by value find both nodes first, in O(log (n)). Code that queries a snapshot many
+	// times should look its nodes up once with index_of() and use the index access members, where
+	// testing for an edge and counting degrees are O(1).
+	template<typename N, typename E>
+	class matrix_view {
+	public:
+		class iterator;
+
+		using value_type = typename graph<N, E>::value_type;
+
+		// --------------------------------------------
+		// Constructors
+		// --------------------------------------------
+
+		matrix_view() = default;
+
+		// The most nodes a snapshot can hold.
+		static constexpr auto max_nodes = std::size_t{8192};
+
+		// Builds the matrices of g, which may have at most max_nodes nodes.
+		// Complexity: O(n² / w + e), where n is the number of stored nodes, e is the number of
+		// stored edges, and w is the number of bits in a word.
+		explicit matrix_view(graph<N, E> const& g) {
+			auto const n = g.graph_.size();
+			if (n > max_nodes) {
+				throw std::runtime_error("Cannot call gdwg::matrix_view<N, E>::matrix_view on a graph "
+				                         "with more than max_nodes nodes");
+			}
+			nodes_.reserve(n);
+			auto index_of = std::unordered_map<typename graph<N, E>::node_handle, std::size_t>{};
+			index_of.reserve(n);
+			for (auto iter = g.graph_.begin(); iter != g.graph_.end(); ++iter) {
+				index_of.emplace(graph<N, E>::handle_of(iter), nodes_.size());
+				nodes_.push_back(iter->first);
+			}
+
+			words_ = (n + word_bits - 1) / word_bits;
+			rows_.assign(n * words_, 0);
+			columns_.assign(n * words_, 0);
+			in_degrees_.assign(n, 0);
+			weights_.reserve(g.edge_count());
+			auto const parallel = std::ranges::any_of(g.graph_, [](auto const& conn) {
+				return conn.second.edges.groups().size() != conn.second.edges.size();
+			});
+			auto src = std::size_t{0};
+			for (auto const& conn : g.graph_) {
+				conn.second.edges.for_each([&](auto dst_handle, E const& weight) {
+					auto const dst = index_of.find(dst_handle)->second;
+					if (!adjacent(src, dst)) {
+						rows_[src * words_ + dst / word_bits] |= bit(dst);
+						columns_[dst * words_ + src / word_bits] |= bit(src);
+						if (parallel) {
+							pair_offsets_.push_back(weights_.size());
+						}
+					}
+					weights_.push_back(weight);
+					++in_degrees_[dst];
+				});
+				++src;
+			}
+
+			if (parallel) {
+				pair_offsets_.push_back(weights_.size());
+			}
+
+			row_ranks_.reserve(n + 1);
+			word_ranks_.resize(n * words_);
+			for (auto row = std::size_t{0}; row < n; ++row) {
+				auto rank = std::uint32_t{0};
+				for (auto word = row * words_; word < (row + 1) * words_; ++word) {
+					word_ranks_[word] = rank;
+					rank += static_cast<std::uint32_t>(std::popcount(rows_[word]));
+				}
+				row_ranks_.push_back(row_ranks_.back() + rank);
+			}
+		}
+
+		// Rebuilds a mutable graph holding the same nodes and edges, allocated from resource. The
+		// snapshot is already sorted, so the nodes are appended and the edges bulk inserted without
+		// sorting.
+		// Complexity: O(n² / w + e + p log (n)), where p is the number of distinct (src, dst) pairs.
+		[[nodiscard]] auto
+		thaw(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const
+		   -> graph<N, E> {
+			auto g = graph<N, E>(nodes_.begin(), nodes_.end(), resource);
+			g.insert_edges(begin(), end());
+			return g;
+		}
+
+		// --------------------------------------------
+		// Accessors
+		// --------------------------------------------
+
+		// Returns: true if a node equivalent to value exists in the graph, and false otherwise.
+		// Complexity: O(log (n)) time.
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return std::binary_search(nodes_.begin(), nodes_.end(), value);
+		}
+
+		// Returns: true if there are no nodes in the graph, and false otherwise.
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
+		}
+
+		// Returns: true if an edge src → dst exists in the graph, and false otherwise.
+		// Complexity: O(log (n)).
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const src_index = index_of(src);
+			auto const dst_index = index_of(dst);
+			if (src_index == npos || dst_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::matrix_view<N, E>::is_connected if src or "
+				                         "dst node don't exist in the graph");
+			}
+			return adjacent(src_index, dst_index);
+		}
+
+		// Returns: A sequence of all stored nodes, sorted in ascending order.
+		// Complexity: O(n).
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return nodes_;
+		}
+
+		// Returns: A sequence of weights from src to dst, sorted in ascending order.
+		// Complexity: O(log (n) + k), where k is the number of weights returned.
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const src_index = index_of(src);
+			auto const dst_index = index_of(dst);
+			if (src_index == npos || dst_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::matrix_view<N, E>::weights if src or dst "
+				                         "node don't exist in the graph");
+			}
+			if (!adjacent(src_index, dst_index)) {
+				return {};
+			}
+			auto const pair = pair_rank(src_index, dst_index);
+			return std::vector<E>(weight_iter(pair_begin(pair)), weight_iter(pair_begin(pair + 1)));
+		}
+
+		// Returns: An iterator pointing to an edge equivalent to value_type{src, dst, weight}, or
+		// end() if no such edge exists.
+		// Complexity: O(log (n) + log (k)), where k is the number of weights from src to dst.
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const src_index = index_of(src);
+			auto const dst_index = index_of(dst);
+			if (src_index == npos || dst_index == npos || !adjacent(src_index, dst_index)) {
+				return end();
+			}
+
+			auto const pair = pair_rank(src_index, dst_index);
+			auto const last = weight_iter(pair_begin(pair + 1));
+			auto const edge = std::lower_bound(weight_iter(pair_begin(pair)), last, weight);
+			if (edge == last || *edge != weight) {
+				return end();
+			}
+			return iterator(this,
+			                src_index,
+			                dst_index,
+			                pair,
+			                static_cast<std::size_t>(edge - weights_.begin()));
+		}
+
+		// Returns: A sequence of nodes (found from any immediate outgoing edge) connected to src,
+		// sorted in ascending order, with respect to the connected nodes.
+		// Complexity: O(log (n) + n / w + k), where k is the number of nodes returned.
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const src_index = index_of(src);
+			if (src_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::matrix_view<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+
+			auto res = std::vector<N>{};
+			res.reserve(row_ranks_[src_index + 1] - row_ranks_[src_index]);
+			for_each_bit(out_bits(src_index), [&](std::size_t dst) { res.push_back(nodes_[dst]); });
+			return res;
+		}
+
+		// Returns: The number of edges leaving src, counting parallel edges separately.
+		// Complexity: O(log (n)).
+		[[nodiscard]] auto out_degree(N const& src) const -> std::size_t {
+			auto const src_index = index_of(src);
+			if (src_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::matrix_view<N, E>::out_degree if src "
+				                         "doesn't exist in the graph");
+			}
+			return out_edge_count(src_index);
+		}
+
+		// Returns: The number of edges entering dst, counting parallel edges separately.
+		// Complexity: O(log (n)).
+		[[nodiscard]] auto in_degree(N const& dst) const -> std::size_t {
+			auto const dst_index = index_of(dst);
+			if (dst_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::matrix_view<N, E>::in_degree if dst "
+				                         "doesn't exist in the graph");
+			}
+			return in_edge_count(dst_index);
+		}
+
+		// Returns: The number of nodes that both a and b have an outgoing edge to.
+		// Complexity: O(log (n) + n / w).
+		[[nodiscard]] auto common_connections(N const& a, N const& b) const -> std::size_t {
+			auto const a_index = index_of(a);
+			auto const b_index = index_of(b);
+			if (a_index == npos || b_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::matrix_view<N, E>::common_connections if a "
+				                         "or b node don't exist in the graph");
+			}
+			return shared_targets(a_index, b_index);
+		}
+
+		// Returns: The number of nodes that have an outgoing edge to both a and b.
+		// Complexity: O(log (n) + n / w).
+		[[nodiscard]] auto common_sources(N const& a, N const& b) const -> std::size_t {
+			auto const a_index = index_of(a);
+			auto const b_index = index_of(b);
+			if (a_index == npos || b_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::matrix_view<N, E>::common_sources if a or "
+				                         "b node don't exist in the graph");
+			}
+			return shared_sources(a_index, b_index);
+		}
+
+		// --------------------------------------------
+		// Index access
+		// --------------------------------------------
+		// Nodes are numbered by their position in nodes(). Rows are exposed as words, so that set
+		// operations over neighbourhoods can run a word at a time: node j is in a row when bit
+		// j % 64 of word j / 64 is set, and bits past the last node are always clear.
+
+		static constexpr auto npos = static_cast<std::size_t>(-1);
+
+		// Returns: The number of stored nodes.
+		[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+			return nodes_.size();
+		}
+
+		// Returns: The number of stored edges.
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return weights_.size();
+		}
+
+		// Returns: The index of the node equivalent to value, or npos if there is none.
+		// Complexity: O(log (n)).
+		[[nodiscard]] auto index_of(N const& value) const -> std::size_t {
+			auto const iter = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (iter == nodes_.end() || value < *iter) {
+				return npos;
+			}
+			return static_cast<std::size_t>(iter - nodes_.begin());
+		}
+
+		// Returns: The node at index i.
+		[[nodiscard]] auto node_at(std::size_t i) const -> N const& {
+			return nodes_[i];
+		}
+
+		// Returns: true if there is an edge from the node at index i to the node at index j, and
+		// false otherwise.
+		// Complexity: O(1).
+		[[nodiscard]] auto adjacent(std::size_t i, std::size_t j) const noexcept -> bool {
+			return (rows_[i * words_ + j / word_bits] & bit(j)) != 0;
+		}
+
+		// Returns: The number of edges leaving the node at index i.
+		// Complexity: O(1).
+		[[nodiscard]] auto out_edge_count(std::size_t i) const noexcept -> std::size_t {
+			return pair_begin(row_ranks_[i + 1]) - pair_begin(row_ranks_[i]);
+		}
+
+		// Returns: The number of edges entering the node at index j.
+		// Complexity: O(1).
+		[[nodiscard]] auto in_edge_count(std::size_t j) const noexcept -> std::size_t {
+			return in_degrees_[j];
+		}
+
+		// Returns: The number of nodes that the nodes at indices i and j both have an edge to.
+		// Complexity: O(n / w).
+		[[nodiscard]] auto shared_targets(std::size_t i, std::size_t j) const noexcept
+		   -> std::size_t {
+			return count_common(out_bits(i), out_bits(j));
+		}
+
+		// Returns: The number of nodes that have an edge to both of the nodes at indices i and j.
+		// Complexity: O(n / w).
+		[[nodiscard]] auto shared_sources(std::size_t i, std::size_t j) const noexcept
+		   -> std::size_t {
+			return count_common(in_bits(i), in_bits(j));
+		}
+
+		// Returns: The words of row i, holding the nodes the node at index i has an edge to.
+		[[nodiscard]] auto out_bits(std::size_t i) const -> std::span<std::uint64_t const> {
+			return std::span<std::uint64_t const>(rows_).subspan(i * words_, words_);
+		}
+
+		// Returns: The words of column j, holding the nodes that have an edge to the node at index j.
+		[[nodiscard]] auto in_bits(std::size_t j) const -> std::span<std::uint64_t const> {
+			return std::span<std::uint64_t const>(columns_).subspan(j * words_, words_);
+		}
+
+		// --------------------------------------------
+		// Iterator access
+		// --------------------------------------------
+
+		// Returns: An iterator pointing to the first element in the container.
+		[[nodiscard]] auto begin() const -> iterator {
+			if (weights_.empty()) {
+				return end();
+			}
+			auto row = std::size_t{0};
+			while (row_ranks_[row + 1] == 0) {
+				++row;
+			}
+			return iterator(this, row, next_bit(row, 0), 0, 0);
+		}
+
+		// Returns: An iterator denoting the end of the iterable list that begin() points to.
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(this, nodes_.size(), 0, pair_count(), weights_.size());
+		}
+
+		// --------------------------------------------
+		// Comparisons
+		// --------------------------------------------
+
+		// Returns: true if *this and other contain exactly the same nodes and edges, and false
+		// otherwise.
+		// Complexity: O(n² / w + e).
+		[[nodiscard]] auto operator==(matrix_view const& other) const -> bool {
+			// the transposed matrix and the ranks follow from the others
+			return nodes_ == other.nodes_ && rows_ == other.rows_
+			       && pair_offsets_ == other.pair_offsets_ && weights_ == other.weights_;
+		}
+
+		// --------------------------------------------
+		// Extractor
+		// --------------------------------------------
+
+		// Behaves as a formatted output function of os, producing the same output as the graph the
+		// matrices were built from.
+		friend auto operator<<(std::ostream& os, matrix_view const& g) -> std::ostream& {
+			auto out = output_buffer(os);
+			auto pair = std::size_t{0};
+			for (auto src = std::size_t{0}; src < g.nodes_.size(); ++src) {
+				out.put(g.nodes_[src]);
+				out.put(" (\n");
+				for_each_bit(g.out_bits(src), [&](std::size_t dst) {
+					for (auto edge = g.pair_begin(pair); edge < g.pair_begin(pair + 1); ++edge) {
+						out.put_edge(g.nodes_[dst], g.weights_[edge]);
+					}
+					++pair;
+				});
+				out.put(")\n");
+			}
+			out.flush();
+			return os;
+		}
+
+	private:
+		using output_buffer = typename graph<N, E>::output_buffer;
+
+		static constexpr auto word_bits = std::size_t{64};
+
+		std::vector<N> nodes_;
+		std::size_t words_ = 0;
+		// n rows of words_ words each; bit j of row i is set when there is an edge i → j
+		std::vector<std::uint64_t> rows_;
+		// the transpose of rows_
+		std::vector<std::uint64_t> columns_;
+		// the number of set bits in the rows before each row, and the total at the back
+		std::vector<std::size_t> row_ranks_ = std::vector<std::size_t>{0};
+		// the number of set bits in the row before each word
+		std::vector<std::uint32_t> word_ranks_;
+		// where the weights of each set bit start, or empty if there are no parallel edges
+		std::vector<std::size_t> pair_offsets_;
+		std::vector<E> weights_;
+		std::vector<std::size_t> in_degrees_;
+
+		[[nodiscard]] static constexpr auto bit(std::size_t j) noexcept -> std::uint64_t {
+			return std::uint64_t{1} << (j % word_bits);
+		}
+
+		// Returns the number of nodes held by both a and b.
+		[[nodiscard]] static auto
+		count_common(std::span<std::uint64_t const> a, std::span<std::uint64_t const> b) noexcept
+		   -> std::size_t {
+			auto count = std::size_t{0};
+			for (auto word = std::size_t{0}; word < a.size(); ++word) {
+				count += static_cast<std::size_t>(std::popcount(a[word] & b[word]));
+			}
+			return count;
+		}
+
+		// Calls f with the index of each node held by bits, in ascending order.
+		template<typename F>
+		static auto for_each_bit(std::span<std::uint64_t const> bits, F f) -> void {
+			for (auto word = std::size_t{0}; word < bits.size(); ++word) {
+				for (auto rest = bits[word]; rest != 0; rest &= rest - 1) {
+					f(word * word_bits + static_cast<std::size_t>(std::countr_zero(rest)));
+				}
+			}
+		}
+
+		// Returns the row-major rank of the set bit for i → j.
+		[[nodiscard]] auto pair_rank(std::size_t i, std::size_t j) const noexcept -> std::size_t {
+			auto const word = i * words_ + j / word_bits;
+			auto const below = rows_[word] & (bit(j) - 1);
+			return row_ranks_[i] + word_ranks_[word] + static_cast<std::size_t>(std::popcount(below));
+		}
+
+		// Returns the number of set bits.
+		[[nodiscard]] auto pair_count() const noexcept -> std::size_t {
+			return pair_offsets_.empty() ? weights_.size() : pair_offsets_.size() - 1;
+		}
+
+		// Returns the index of the first weight of the set bit of rank pair.
+		[[nodiscard]] auto pair_begin(std::size_t pair) const noexcept -> std::size_t {
+			return pair_offsets_.empty() ? pair : pair_offsets_[pair];
+		}
+
+		[[nodiscard]] auto weight_iter(std::size_t edge) const {
+			return weights_.begin() + static_cast<std::ptrdiff_t>(edge);
+		}
+
+		// Returns the first column at or after from whose bit is set in row, or node_count() if
+		// there is none.
+		[[nodiscard]] auto next_bit(std::size_t row, std::size_t from) const noexcept -> std::size_t {
+			if (from >= nodes_.size()) {
+				return nodes_.size();
+			}
+			auto word = from / word_bits;
+			auto rest = rows_[row * words_ + word] & ~(bit(from) - 1);
+			while (rest == 0) {
+				if (++word == words_) {
+					return nodes_.size();
+				}
+				rest = rows_[row * words_ + word];
+			}
+			return word * word_bits + static_cast<std::size_t>(std::countr_zero(rest));
+		}
+
+		// Returns the last column before before whose bit is set in row, or npos if there is none.
+		[[nodiscard]] auto prev_bit(std::size_t row, std::size_t before) const noexcept
+		   -> std::size_t {
+			if (before == 0) {
+				return npos;
+			}
+			auto word = (before - 1) / word_bits;
+			auto const last = (before - 1) % word_bits;
+			auto rest = rows_[row * words_ + word] & (~std::uint64_t{0} >> (word_bits - 1 - last));
+			while (rest == 0) {
+				if (word-- == 0) {
+					return npos;
+				}
+				rest = rows_[row * words_ + word];
+			}
+			return word * word_bits + word_bits - 1 - static_cast<std::size_t>(std::countl_zero(rest));
+		}
+	};
+
+	template<typename N, typename E>
+	class matrix_view<N, E>::iterator {
+	public:
+		using value_type = matrix_view<N, E>::value_type;
+		using reference = value_type;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::bidirectional_iterator_tag;
+
+		// Value-initialises all members.
+		iterator() = default;
+
+		// Returns the current from, to, and weight.
+		auto operator*() const -> reference {
+			return value_type{view_->nodes_[row_], view_->nodes_[column_], view_->weights_[edge_]};
+		}
+
+		// Advances *this to the next element in the iterable list.
+		auto operator++() -> iterator& {
+			++edge_;
+			if (edge_ != view_->pair_begin(pair_ + 1)) {
+				return *this;
+			}
+
+			++pair_;
+			if (pair_ == view_->pair_count()) {
+				row_ = view_->nodes_.size();
+				column_ = 0;
+				return *this;
+			}
+			auto from = column_ + 1;
+			while (view_->row_ranks_[row_ + 1] == pair_) {
+				++row_;
+				from = 0;
+			}
+			column_ = view_->next_bit(row_, from);
+			return *this;
+		}
+
+		// Advances *this to the next element in the iterable list and returns *this.
+		auto operator++(int) -> iterator {
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		// Advances *this to the previous element in the iterable list.
+		auto operator--() -> iterator& {
+			if (row_ == view_->nodes_.size() || edge_ == view_->pair_begin(pair_)) {
+				--pair_;
+				auto before = column_;
+				while (view_->row_ranks_[row_] > pair_) {
+					--row_;
+					before = view_->nodes_.size();
+				}
+				column_ = view_->prev_bit(row_, before);
+			}
+			--edge_;
+			return *this;
+		}
+
+		// Advances *this to the previous element in the iterable list and returns *this.
+		auto operator--(int) -> iterator {
+			auto temp = *this;
+			--*this;
+			return temp;
+		}
+
+		// Returns: true if *this and other are pointing to the same elements in the same iterable
+		// list, and false otherwise.
+		auto operator==(iterator const& other) const -> bool {
+			return view_ == other.view_ && edge_ == other.edge_;
+		}
+
+	private:
+		matrix_view const* view_ = nullptr;
+		std::size_t row_ = 0;
+		std::size_t column_ = 0;
+		std::size_t pair_ = 0;
+		std::size_t edge_ = 0;
+
+		// Constructs an iterator to the edge at index edge, which belongs to the set bit of rank
+		// pair, at row row and column column.
+		explicit iterator(matrix_view const* view,
+		                  std::size_t row,
+		                  std::size_t column,
+		                  std::size_t pair,
+		                  std::size_t edge)
+		: view_{view}
+		, row_{row}
+		, column_{column}
+		, pair_{pair}
+		, edge_{edge} {}
+
+		friend class matrix_view;
+	};
+} // namespace gdwg
+
+#endif // GDWG_MATRIX_VIEW_HPP
@@ -0,0 +1,171 @@
+#include "gdwg/algorithms.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto make_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+		g.insert_edge("a", "b", 7);
+		g.insert_edge("a", "c", 2);
+		g.insert_edge("c", "b", 3);
+		g.insert_edge("b", "d", 1);
+		g.insert_edge("c", "d", 8);
+		g.insert_edge("d", "a", 1);
+		g.insert_edge("e", "a", 1);
+		return g;
+	}
+
+	// Returns a graph with nodes nodes and about 4 × nodes random edges.
+	auto make_random_graph(int nodes, unsigned seed) -> gdwg::graph<int, int> {
+		auto engine = std::mt19937{seed};
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 20);
+		auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+		for (auto i = 0; i < 4 * nodes; ++i) {
+			edges.push_back({node(engine), node(engine), weight(engine)});
+		}
+		auto g = gdwg::graph<int, int>::from_edges(edges.begin(), edges.end());
+		g.insert_node(0);
+		return g;
+	}
+} // namespace
+
+TEST_CASE("Shortest paths (dijkstra())") {
+	auto const& g = make_graph();
+	auto const expected =
+	   std::vector<std::pair<std::string, int>>{{"a", 0}, {"b", 5}, {"c", 2}, {"d", 6}};
+
+	SECTION("Distances are found for every reachable node") {
+		CHECK(gdwg::dijkstra(g, std::string("a")) == expected);
+		CHECK(gdwg::dijkstra(gdwg::freeze(g), std::string("a")) == expected);
+	}
+
+	SECTION("Nodes with no outgoing edges only reach themselves") {
+		auto h = g;
+		REQUIRE(h.insert_node("f"));
+		CHECK(gdwg::dijkstra(h, std::string("f"))
+		      == std::vector<std::pair<std::string, int>>{{"f", 0}});
+	}
+
+	SECTION("dijkstra() throws on a missing src or negative weights") {
+		CHECK_THROWS_WITH(gdwg::dijkstra(g, std::string("z")),
+		                  "Cannot call gdwg::dijkstra if src doesn't exist in the graph");
+
+		auto h = g;
+		REQUIRE(h.insert_edge("e", "b", -1));
+		CHECK_THROWS_WITH(gdwg::dijkstra(h, std::string("a")),
+		                  "Cannot call gdwg::dijkstra on a graph with negative edge weights");
+	}
+}
+
+TEST_CASE("Parallel shortest paths (delta_stepping())") {
+	auto const& g = make_graph();
+
+	SECTION("Distances match dijkstra() for any delta and thread count") {
+		auto const expected = gdwg::dijkstra(g, std::string("a"));
+		for (auto const delta : {1, 2, 5, 100}) {
+			for (auto const threads : {1U, 4U}) {
+				CHECK(gdwg::delta_stepping(g, std::string("a"), delta, threads) == expected);
+			}
+		}
+	}
+
+	SECTION("Distances match dijkstra() on larger random graphs") {
+		for (auto const seed : {1U, 2U, 3U}) {
+			auto const h = gdwg::freeze(make_random_graph(3000, seed));
+			auto const expected = gdwg::dijkstra(h, 0);
+			CHECK(gdwg::delta_stepping(h, 0, 5, 4) == expected);
+			CHECK(gdwg::delta_stepping(h, 0, 1, 2) == expected);
+		}
+	}
+
+	SECTION("Floating point weights are supported") {
+		auto h = gdwg::graph<int, double>{1, 2, 3};
+		h.insert_edge(1, 2, 0.5);
+		h.insert_edge(2, 3, 0.25);
+		h.insert_edge(1, 3, 1.0);
+		CHECK(gdwg::delta_stepping(h, 1, 0.3, 2)
+		      == std::vector<std::pair<int, double>>{{1, 0.0}, {2, 0.5}, {3, 0.75}});
+	}
+
+	SECTION("delta_stepping() throws on a missing src, a non-positive delta or negative weights") {
+		CHECK_THROWS_WITH(gdwg::delta_stepping(g, std::string("z"), 1),
+		                  "Cannot call gdwg::delta_stepping if src doesn't exist in the graph");
+		CHECK_THROWS_WITH(gdwg::delta_stepping(g, std::string("a"), 0),
+		                  "Cannot call gdwg::delta_stepping with a delta that isn't positive");
+
+		auto h = g;
+		REQUIRE(h.insert_edge("e", "b", -1));
+		CHECK_THROWS_WITH(gdwg::delta_stepping(h, std::string("a"), 1),
+		                  "Cannot call gdwg::delta_stepping on a graph with negative edge weights");
+	}
+}
+
+TEST_CASE("Breadth-first search (bfs())") {
+	auto const& g = make_graph();
+
+	SECTION("Every reachable node is visited with its depth and parent") {
+		auto const& res = gdwg::bfs(g, std::string("a"), 1);
+		using visit = gdwg::bfs_visit<std::string>;
+		CHECK(res.visits
+		      == std::vector<visit>{{"a", 0, "a"}, {"b", 1, "a"}, {"c", 1, "a"}, {"d", 2, "b"}});
+		CHECK(res.edges_traversed == 6);
+		CHECK(res.edges_per_second() >= 0);
+	}
+
+	SECTION("Depths match the unit-weight shortest paths on larger random graphs") {
+		for (auto const seed : {1U, 2U, 3U}) {
+			auto const h = make_random_graph(3000, seed);
+			auto const nodes = h.nodes();
+			auto unit = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+			for (auto const& [from, to, _] : h) {
+				unit.insert_edge(from, to, 1);
+			}
+			auto const& expected = gdwg::dijkstra(unit, 0);
+
+			for (auto const threads : {1U, 4U}) {
+				auto const& res = gdwg::bfs(h, 0, threads);
+				REQUIRE(res.visits.size() == expected.size());
+				for (auto i = std::size_t{0}; i < expected.size(); ++i) {
+					auto const& [node, depth, parent] = res.visits[i];
+					CHECK(node == expected[i].first);
+					CHECK(depth == static_cast<std::size_t>(expected[i].second));
+					if (node != 0) {
+						CHECK(h.is_connected(parent, node));
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Wide graphs are traversed bottom-up and give the same result") {
+		// a star from 0 fans out to every node, so the second level is expanded bottom-up
+		auto edges = std::vector<gdwg::graph<std::uint64_t, double>::value_type>{};
+		for (auto i = std::uint64_t{1}; i < 2000; ++i) {
+			edges.push_back({0, i, 1.0});
+			edges.push_back({i, (i * 7) % 2000 + 2000, 1.0});
+		}
+		auto const h = gdwg::graph<std::uint64_t, double>::from_edges(edges.begin(), edges.end());
+		for (auto const threads : {1U, 4U}) {
+			auto const& res = gdwg::bfs(h, std::uint64_t{0}, threads);
+			CHECK(res.visits.size() == h.node_count());
+			for (auto const& [node, depth, parent] : res.visits) {
+				CHECK(depth == (node == 0 ? 0 : node < 2000 ? 1 : 2));
+				if (node != 0) {
+					CHECK(h.is_connected(parent, node));
+				}
+			}
+		}
+	}
+
+	SECTION("bfs() throws on a missing src") {
+		CHECK_THROWS_WITH(gdwg::bfs(g, std::string("z")),
+		                  "Cannot call gdwg::bfs if src doesn't exist in the graph");
+	}
+}
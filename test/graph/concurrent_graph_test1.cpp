@@ -0,0 +1,117 @@
+#include "gdwg/concurrent_graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Snapshots (snapshot(), update())") {
+	auto g = gdwg::concurrent_graph<int, int>(gdwg::graph<int, int>{1, 2, 3});
+	REQUIRE(g.version() == 0);
+
+	SECTION("Snapshots are unaffected by later updates") {
+		auto const before = g.snapshot();
+		CHECK(g.update([](gdwg::graph<int, int>& next) { return next.insert_edge(1, 2, 5); }));
+		CHECK(g.version() == 1);
+		CHECK(before->edge_count() == 0);
+		CHECK(g.snapshot()->weights(1, 2) == std::vector{5});
+		CHECK(g.is_connected(1, 2));
+	}
+
+	SECTION("Batches are published at once") {
+		auto const added = g.update([](gdwg::graph<int, int>& next) {
+			next.insert_edge(1, 2, 1);
+			next.insert_edge(2, 3, 1);
+			return next.erase_node(1);
+		});
+		CHECK(added);
+		CHECK(g.version() == 1);
+		CHECK(g.nodes() == std::vector{2, 3});
+		CHECK(g.edge_count() == 1);
+	}
+
+	SECTION("A failed update publishes nothing") {
+		CHECK_THROWS_AS(g.update([](gdwg::graph<int, int>& next) { next.insert_edge(1, 4, 1); }),
+		                std::runtime_error);
+		CHECK_THROWS_AS(g.update([](gdwg::graph<int, int>& next) {
+			next.insert_node(4);
+			next.merge_replace_node(5, 1);
+		}),
+		                std::runtime_error);
+		CHECK(g.version() == 0);
+		CHECK_FALSE(g.is_node(4));
+	}
+
+	SECTION("Edge batches and clearing publish once each") {
+		auto const edges = std::vector<gdwg::graph<int, int>::value_type>{{1, 2, 1}, {3, 1, 2}};
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == 2);
+		CHECK(g.connections(3) == std::vector{1});
+		CHECK(g.weights(1, 2) == std::vector{1});
+		g.clear();
+		CHECK(g.empty());
+		CHECK(g.version() == 2);
+	}
+
+	SECTION("Accessors follow updates and tell graphs apart") {
+		auto other = gdwg::concurrent_graph<int, int>(gdwg::graph<int, int>{7});
+		CHECK(g.node_count() == 3);
+		CHECK(other.nodes() == std::vector{7});
+		g.update([](gdwg::graph<int, int>& next) { next.insert_node(4); });
+		CHECK(g.is_node(4));
+		CHECK_FALSE(other.is_node(4));
+		CHECK(g.node_count() == 4);
+	}
+
+	SECTION("Readers only reload after a publish") {
+		auto r = gdwg::concurrent_graph<int, int>::reader(g);
+		auto const* first = &r.snapshot();
+		CHECK(&r.snapshot() == first);
+		REQUIRE(g.update([](gdwg::graph<int, int>& next) { return next.insert_edge(3, 1, 2); }));
+		auto const& latest = r.snapshot();
+		CHECK(&latest != first);
+		CHECK(latest.is_connected(3, 1));
+	}
+}
+
+TEST_CASE("Readers see consistent snapshots while a writer publishes") {
+	// every published graph is a chain 0 → 1 → ... → k, so any torn state would break the count
+	auto g = gdwg::concurrent_graph<int, int>(gdwg::graph<int, int>{0});
+	constexpr auto length = 200;
+	auto done = std::atomic<bool>{false};
+	auto failures = std::atomic<int>{0};
+
+	auto readers = std::vector<std::jthread>{};
+	for (auto t = 0; t < 4; ++t) {
+		readers.emplace_back([&] {
+			auto r = gdwg::concurrent_graph<int, int>::reader(g);
+			while (!done.load()) {
+				auto const& snapshot = r.snapshot();
+				if (snapshot.edge_count() + 1 != snapshot.node_count()) {
+					++failures;
+				}
+				auto edges = std::size_t{0};
+				for (auto iter = snapshot.begin(); iter != snapshot.end(); ++iter) {
+					++edges;
+				}
+				if (edges != snapshot.edge_count()) {
+					++failures;
+				}
+			}
+		});
+	}
+
+	for (auto i = 1; i <= length; ++i) {
+		g.update([i](gdwg::graph<int, int>& next) {
+			next.insert_node(i);
+			next.insert_edge(i - 1, i, i);
+		});
+	}
+	done = true;
+	readers.clear();
+
+	CHECK(failures == 0);
+	CHECK(g.edge_count() == length);
+	CHECK(g.version() == length);
+}
@@ -0,0 +1,132 @@
+#include "gdwg/csr_file.hpp"
+
+#include "gdwg/algorithms.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	// A file path in the temporary directory that is removed once the test is done with it.
+	class temporary_file {
+	public:
+		explicit temporary_file(std::string const& name)
+		: path_{std::filesystem::temp_directory_path() / ("gdwg_csr_file_test1_" + name)} {}
+
+		temporary_file(temporary_file const&) = delete;
+		auto operator=(temporary_file const&) -> temporary_file& = delete;
+
+		~temporary_file() {
+			auto ec = std::error_code{};
+			std::filesystem::remove(path_, ec);
+		}
+
+		[[nodiscard]] auto path() const -> std::filesystem::path const& {
+			return path_;
+		}
+
+	private:
+		std::filesystem::path path_;
+	};
+
+	auto make_graph() -> gdwg::graph<std::int32_t, double> {
+		auto g = gdwg::graph<std::int32_t, double>{1, 2, 3, 4, 5};
+		g.insert_edge(1, 2, 3.5);
+		g.insert_edge(1, 2, 1.0);
+		g.insert_edge(1, 3, 2.0);
+		g.insert_edge(3, 1, 4.0);
+		g.insert_edge(3, 3, 5.0);
+		g.insert_edge(4, 3, 0.5);
+		return g;
+	}
+} // namespace
+
+TEST_CASE("Binary files (write_binary() and map_binary())") {
+	auto const& g = make_graph();
+	auto const file = temporary_file("graph");
+	gdwg::write_binary(g, file.path());
+
+	SECTION("A mapped file holds the same snapshot as freeze()") {
+		auto const& view = gdwg::map_binary<std::int32_t, double>(file.path());
+		CHECK(view == gdwg::freeze(g));
+		CHECK(view.thaw() == g);
+		CHECK(view.node_count() == 5);
+		CHECK(view.edge_count() == 6);
+	}
+
+	SECTION("Accessors and index access work on the mapped arrays") {
+		auto const& view = gdwg::map_binary<std::int32_t, double>(file.path());
+		CHECK(view.is_node(5));
+		CHECK_FALSE(view.is_node(6));
+		CHECK(view.is_connected(1, 2));
+		CHECK(view.weights(1, 2) == std::vector{1.0, 3.5});
+		CHECK(view.connections(3) == std::vector<std::int32_t>{1, 3});
+		CHECK(view.find(4, 3, 0.5) != view.end());
+
+		auto const three = view.index_of(3);
+		auto const sources = std::vector<std::size_t>{view.index_of(1), three, view.index_of(4)};
+		CHECK(std::ranges::equal(view.sources(three), sources));
+		CHECK(gdwg::dijkstra(view, 1) == gdwg::dijkstra(g, 1));
+	}
+
+	SECTION("Copies keep the file mapped") {
+		auto copy = gdwg::csr_view<std::int32_t, double>();
+		{
+			auto const view = gdwg::map_binary<std::int32_t, double>(file.path());
+			copy = view;
+		}
+		CHECK(copy == gdwg::freeze(g));
+	}
+
+	SECTION("Empty graphs round trip") {
+		auto const empty = temporary_file("empty");
+		gdwg::write_binary(gdwg::graph<std::int32_t, double>{}, empty.path());
+		auto const& view = gdwg::map_binary<std::int32_t, double>(empty.path());
+		CHECK(view.empty());
+		CHECK(view.begin() == view.end());
+	}
+
+	SECTION("map_binary() throws on files it can't use") {
+		CHECK_THROWS_WITH((gdwg::map_binary<std::int32_t, double>(file.path() / "missing")),
+		                  "Cannot call gdwg::map_binary on a file that can't be opened");
+		CHECK_THROWS_WITH((gdwg::map_binary<std::int64_t, double>(file.path())),
+		                  "Cannot call gdwg::map_binary on a file that wasn't written for this graph "
+		                  "type");
+
+		std::filesystem::resize_file(file.path(), std::filesystem::file_size(file.path()) - 1);
+		CHECK_THROWS_WITH((gdwg::map_binary<std::int32_t, double>(file.path())),
+		                  "Cannot call gdwg::map_binary on a file that is truncated");
+
+		std::filesystem::resize_file(file.path(), 4);
+		CHECK_THROWS_WITH((gdwg::map_binary<std::int32_t, double>(file.path())),
+		                  "Cannot call gdwg::map_binary on a file that can't be mapped");
+	}
+
+	SECTION("map_binary() throws on counts that would wrap around the file size") {
+		using header = gdwg::csr_file<std::int32_t, double>::header;
+		// each count times its element size wraps around to 0, so unchecked offsets would fit
+		for (auto const& [nodes, edges] : {std::pair{std::uint64_t{1} << 62, std::uint64_t{0}},
+		                                   std::pair{std::uint64_t{0}, std::uint64_t{1} << 61},
+		                                   std::pair{~std::uint64_t{0}, std::uint64_t{0}}})
+		{
+			auto const corrupt = temporary_file("corrupt");
+			gdwg::write_binary(gdwg::graph<std::int32_t, double>{}, corrupt.path());
+			{
+				auto os = std::fstream(corrupt.path(), std::ios::binary | std::ios::in | std::ios::out);
+				os.seekp(offsetof(header, node_count));
+				os.write(reinterpret_cast<char const*>(&nodes), sizeof(nodes));
+				os.seekp(offsetof(header, edge_count));
+				os.write(reinterpret_cast<char const*>(&edges), sizeof(edges));
+			}
+			CHECK_THROWS_WITH((gdwg::map_binary<std::int32_t, double>(corrupt.path())),
+			                  "Cannot call gdwg::map_binary on a file that is truncated");
+		}
+	}
+}
@@ -0,0 +1,146 @@
+#include "gdwg/csr_view.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	auto make_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+		g.insert_edge("a", "b", 3);
+		g.insert_edge("a", "b", 1);
+		g.insert_edge("a", "c", 2);
+		g.insert_edge("c", "a", 4);
+		g.insert_edge("c", "c", 5);
+		return g;
+	}
+} // namespace
+
+TEST_CASE("Freezing a graph (freeze())") {
+	auto const& g = make_graph();
+	auto const& view = gdwg::freeze(g);
+
+	SECTION("Accessors match the original graph") {
+		CHECK(view.nodes() == g.nodes());
+		CHECK_FALSE(view.empty());
+		CHECK(view.is_node("d"));
+		CHECK_FALSE(view.is_node("e"));
+
+		CHECK(view.is_connected("a", "b"));
+		CHECK_FALSE(view.is_connected("b", "a"));
+		CHECK(view.weights("a", "b") == std::vector{1, 3});
+		CHECK(view.weights("b", "a").empty());
+		CHECK(view.connections("a") == std::vector<std::string>{"b", "c"});
+		CHECK(view.connections("d").empty());
+	}
+
+	SECTION("Accessors throw on missing nodes") {
+		CHECK_THROWS_AS(view.is_connected("a", "e"), std::runtime_error);
+		CHECK_THROWS_AS(view.weights("e", "a"), std::runtime_error);
+		CHECK_THROWS_AS(view.connections("e"), std::runtime_error);
+	}
+
+	SECTION("find() locates edges") {
+		auto const& iter = view.find("c", "a", 4);
+		REQUIRE(iter != view.end());
+		auto const& [from, to, weight] = *iter;
+		CHECK(from == "c");
+		CHECK(to == "a");
+		CHECK(weight == 4);
+
+		CHECK(view.find("a", "b", 2) == view.end());
+		CHECK(view.find("a", "e", 1) == view.end());
+		CHECK(view.find("d", "a", 1) == view.end());
+	}
+
+	SECTION("Iteration matches the original graph in both directions") {
+		auto expected = std::vector<std::tuple<std::string, std::string, int>>{};
+		for (auto const& [from, to, weight] : g) {
+			expected.emplace_back(from, to, weight);
+		}
+
+		auto forwards = std::vector<std::tuple<std::string, std::string, int>>{};
+		for (auto const& [from, to, weight] : view) {
+			forwards.emplace_back(from, to, weight);
+		}
+		CHECK(forwards == expected);
+
+		auto backwards = std::vector<std::tuple<std::string, std::string, int>>{};
+		for (auto iter = view.end(); iter != view.begin();) {
+			auto const& [from, to, weight] = *--iter;
+			backwards.emplace_back(from, to, weight);
+		}
+		std::reverse(backwards.begin(), backwards.end());
+		CHECK(backwards == expected);
+	}
+
+	SECTION("Index access exposes outgoing and incoming edges") {
+		auto const a = view.index_of("a");
+		auto const b = view.index_of("b");
+		auto const c = view.index_of("c");
+		CHECK(view.index_of("e") == gdwg::csr_view<std::string, int>::npos);
+		CHECK(view.node_count() == 4);
+		CHECK(view.edge_count() == 5);
+		CHECK(view.node_at(c) == "c");
+		CHECK(std::vector(view.targets(a).begin(), view.targets(a).end())
+		      == std::vector<std::size_t>{b, b, c});
+		CHECK(std::vector(view.edge_weights(a).begin(), view.edge_weights(a).end())
+		      == std::vector{1, 3, 2});
+		CHECK(std::vector(view.sources(b).begin(), view.sources(b).end())
+		      == std::vector<std::size_t>{a, a});
+		CHECK(std::vector(view.sources(c).begin(), view.sources(c).end())
+		      == std::vector<std::size_t>{a, c});
+		CHECK(view.sources(view.index_of("d")).empty());
+	}
+
+	SECTION("The extractor output matches the original graph") {
+		auto graph_out = std::ostringstream{};
+		auto view_out = std::ostringstream{};
+		graph_out << g;
+		view_out << view;
+		CHECK(view_out.str() == graph_out.str());
+	}
+
+	SECTION("Thawing gives back an equal graph") {
+		CHECK(view.thaw() == g);
+		CHECK(gdwg::freeze(view.thaw()) == view);
+	}
+}
+
+TEST_CASE("Freezing an empty graph") {
+	auto const& view = gdwg::freeze(gdwg::graph<int, int>{});
+	CHECK(view.empty());
+	CHECK(view.begin() == view.end());
+	CHECK(view == gdwg::csr_view<int, int>{});
+	CHECK(view.thaw().empty());
+}
+
+TEST_CASE("Freezing a graph with edgeless nodes") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+	g.insert_edge(2, 4, 1);
+	auto const& view = gdwg::freeze(g);
+	REQUIRE(view.begin() != view.end());
+	CHECK(std::next(view.begin()) == view.end());
+	auto const& [from, to, weight] = *view.begin();
+	CHECK(from == 2);
+	CHECK(to == 4);
+	CHECK(weight == 1);
+	CHECK(view != gdwg::freeze(gdwg::graph<int, int>{1, 2, 3, 4}));
+}
+
+TEST_CASE("Freezing a graph with bool weights") {
+	auto g = gdwg::graph<int, bool>{1, 2, 3};
+	g.insert_edge(1, 2, true);
+	g.insert_edge(1, 2, false);
+	g.insert_edge(2, 3, true);
+	g.insert_edge(3, 3, false);
+	auto const& view = gdwg::freeze(g);
+	CHECK(view.weights(1, 2) == std::vector{false, true});
+	CHECK(std::ranges::equal(view.edge_weights(view.index_of(1)), std::vector{false, true}));
+	CHECK(view.find(3, 3, false) != view.end());
+	CHECK(view.thaw() == g);
+	CHECK(gdwg::freeze(view.thaw()) == view);
+}
@@ -0,0 +1,229 @@
+#include "gdwg/dense_graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	template<typename G>
+	auto edges_of(G const& g) -> std::vector<std::tuple<std::uint32_t, std::uint32_t, float>> {
+		auto res = std::vector<std::tuple<std::uint32_t, std::uint32_t, float>>{};
+		for (auto const& [from, to, weight] : g) {
+			res.emplace_back(from, to, weight);
+		}
+		return res;
+	}
+
+	template<typename G>
+	auto dump(G const& g) -> std::string {
+		auto os = std::ostringstream{};
+		os << g;
+		return os.str();
+	}
+} // namespace
+
+TEST_CASE("Dense graphs keep the graph interface") {
+	auto g = gdwg::dense_graph<std::uint32_t, float>{0, 1, 2, 3};
+	CHECK(g.insert_edge(0, 1, 2.5F));
+	CHECK(g.insert_edge(0, 1, 1.5F));
+	CHECK_FALSE(g.insert_edge(0, 1, 1.5F));
+	CHECK(g.insert_edge(2, 0, 1.0F));
+	CHECK(g.insert_edge(2, 2, 4.0F));
+
+	SECTION("Accessors answer as graph does") {
+		CHECK(g.node_count() == 4);
+		CHECK(g.edge_count() == 4);
+		CHECK(g.is_node(3));
+		CHECK_FALSE(g.is_node(4));
+		CHECK(g.is_connected(0, 1));
+		CHECK_FALSE(g.is_connected(1, 0));
+		CHECK(g.weights(0, 1) == std::vector{1.5F, 2.5F});
+		CHECK(g.connections(2) == std::vector<std::uint32_t>{0, 2});
+		CHECK(g.out_degree(0) == 2);
+		CHECK(g.in_degree(0) == 1);
+		CHECK(g.in_degree(2) == 1);
+		CHECK(g.nodes() == std::vector<std::uint32_t>{0, 1, 2, 3});
+		CHECK(std::ranges::distance(g.neighbours(0)) == 1);
+		CHECK(std::ranges::equal(g.weights_view(0, 1), std::vector{1.5F, 2.5F}));
+		CHECK(g.out_edges(2).front() == std::pair<std::uint32_t, float>{0, 1.0F});
+	}
+
+	SECTION("Edges are iterated in the same order as graph") {
+		auto const expected = std::vector<std::tuple<std::uint32_t, std::uint32_t, float>>{
+		   {0, 1, 1.5F},
+		   {0, 1, 2.5F},
+		   {2, 0, 1.0F},
+		   {2, 2, 4.0F}};
+		CHECK(edges_of(g) == expected);
+
+		auto iter = g.end();
+		CHECK((*--iter).weight == 4.0F);
+		CHECK((*--iter).weight == 1.0F);
+		CHECK((*--iter).weight == 2.5F);
+		CHECK(std::next(iter, 2) == g.find(2, 2, 4.0F));
+		CHECK(g.find(2, 2, 5.0F) == g.end());
+	}
+
+	SECTION("Erasing nodes takes their incoming and outgoing edges with them") {
+		CHECK(g.erase_node(0));
+		CHECK_FALSE(g.erase_node(0));
+		CHECK(g.edge_count() == 1);
+		CHECK(g.connections(2) == std::vector<std::uint32_t>{2});
+		CHECK(g.nodes() == std::vector<std::uint32_t>{1, 2, 3});
+	}
+
+	SECTION("Erasing through an iterator returns the next edge") {
+		auto const next = g.erase_edge(g.find(0, 1, 2.5F));
+		CHECK((*next).from == 2);
+		CHECK((*next).to == 0);
+		CHECK(g.erase_edge(g.begin(), g.end()) == g.end());
+		CHECK(g.edge_count() == 0);
+		CHECK(g.in_degree(2) == 0);
+	}
+
+	SECTION("Missing nodes are reported") {
+		CHECK_THROWS_WITH(g.insert_edge(0, 9, 1.0F),
+		                  "Cannot call gdwg::dense_graph<N, E>::insert_edge when either src or dst "
+		                  "node does not exist");
+		CHECK_THROWS_WITH(g.connections(9),
+		                  "Cannot call gdwg::dense_graph<N, E>::connections if src doesn't exist in "
+		                  "the graph");
+		CHECK_THROWS_WITH(g.replace_node(9, 10),
+		                  "Cannot call gdwg::dense_graph<N, E>::replace_node on a node that doesn't "
+		                  "exist");
+	}
+
+	SECTION("Output matches graph") {
+		auto expected = gdwg::graph<std::uint32_t, float>{0, 1, 2, 3};
+		expected.insert_edges(g.begin(), g.end());
+		CHECK(dump(g) == dump(expected));
+	}
+}
+
+TEST_CASE("Dense graphs refuse negative ids") {
+	auto g = gdwg::dense_graph<int, int>{};
+	CHECK_THROWS_WITH(g.insert_node(-1),
+	                  "Cannot call gdwg::dense_graph<N, E>::insert_node on a negative id");
+	CHECK_FALSE(g.is_node(-1));
+	CHECK(g.empty());
+}
+
+TEST_CASE("Dense graphs refuse ids too large to index") {
+	auto g = gdwg::dense_graph<std::size_t, int>{};
+	CHECK_THROWS_WITH(g.insert_node(std::numeric_limits<std::size_t>::max()),
+	                  "Cannot call gdwg::dense_graph<N, E>::insert_node on an id too large to "
+	                  "index");
+	CHECK_FALSE(g.is_node(std::numeric_limits<std::size_t>::max()));
+	CHECK(g.empty());
+}
+
+TEST_CASE("Dense graphs behave exactly like graph") {
+	// applies the same random operations to both, and checks that they always agree
+	auto engine = std::mt19937{11};
+	auto value = std::uniform_int_distribution<std::uint32_t>(0, 149);
+	auto op = std::uniform_int_distribution<int>(0, 99);
+	auto g = gdwg::dense_graph<std::uint32_t, float>{};
+	auto expected = gdwg::graph<std::uint32_t, float>{};
+
+	for (auto step = 0; step < 20000; ++step) {
+		auto const a = value(engine);
+		auto const b = value(engine);
+		auto const weight = static_cast<float>(a % 3);
+		auto const roll = op(engine);
+		if (roll < 25) {
+			REQUIRE(g.insert_node(a) == expected.insert_node(a));
+		}
+		else if (roll < 35) {
+			REQUIRE(g.erase_node(a) == expected.erase_node(a));
+		}
+		else if (roll < 60) {
+			if (expected.is_node(a) && expected.is_node(b)) {
+				REQUIRE(g.insert_edge(a, b, weight) == expected.insert_edge(a, b, weight));
+			}
+		}
+		else if (roll < 70) {
+			if (expected.is_node(a) && expected.is_node(b)) {
+				REQUIRE(g.erase_edge(a, b, weight) == expected.erase_edge(a, b, weight));
+			}
+		}
+		else if (roll < 74) {
+			if (expected.is_node(a)) {
+				REQUIRE(g.replace_node(a, b) == expected.replace_node(a, b));
+			}
+		}
+		else if (roll < 77) {
+			if (expected.is_node(a) && expected.is_node(b)) {
+				g.merge_replace_node(a, b);
+				expected.merge_replace_node(a, b);
+			}
+		}
+		else if (roll < 80) {
+			auto const batch = std::vector<gdwg::graph<std::uint32_t, float>::value_type>{
+			   {a, b, weight},
+			   {b, a, weight},
+			   {a, a, weight}};
+			if (expected.is_node(a) && expected.is_node(b)) {
+				REQUIRE(g.insert_edges(batch.begin(), batch.end())
+				        == expected.insert_edges(batch.begin(), batch.end()));
+			}
+		}
+		else if (roll < 81) {
+			auto const iter = g.find(a, b, weight);
+			if (iter != g.end()) {
+				g.erase_edge(iter);
+				expected.erase_edge(expected.find(a, b, weight));
+			}
+		}
+		else if (roll < 82) {
+			// a run of edges that may span several sources
+			auto const count = static_cast<std::ptrdiff_t>(g.edge_count());
+			auto const first = std::min(static_cast<std::ptrdiff_t>(a), count);
+			auto const last = std::min(first + static_cast<std::ptrdiff_t>(b % 40), count);
+			auto const next = g.erase_edge(std::next(g.begin(), first), std::next(g.begin(), last));
+			expected.erase_edge(std::next(expected.begin(), first),
+			                    std::next(expected.begin(), last));
+			REQUIRE(std::distance(g.begin(), next) == first);
+		}
+		else if (roll < 83) {
+			g = gdwg::dense_graph<std::uint32_t, float>(g);
+		}
+		else if (roll < 84) {
+			auto moved = std::move(g);
+			g = std::move(moved);
+		}
+		else if (expected.is_node(a)) {
+			REQUIRE(g.in_degree(a) == expected.in_degree(a));
+			REQUIRE(g.connections(a) == expected.connections(a));
+		}
+
+		if (step % 500 == 0) {
+			REQUIRE(g.nodes() == expected.nodes());
+			REQUIRE(g.edge_count() == expected.edge_count());
+			REQUIRE(edges_of(g) == edges_of(expected));
+		}
+	}
+
+	using value_type = gdwg::dense_graph<std::uint32_t, float>::value_type;
+	auto const batch = std::vector<value_type>(g.begin(), g.end());
+	auto const rebuilt =
+	   gdwg::dense_graph<std::uint32_t, float>::from_edges(batch.begin(), batch.end());
+	CHECK(edges_of(rebuilt) == edges_of(g));
+	CHECK(dump(g) == dump(expected));
+
+	// from_edges() only adds the nodes that have edges
+	auto with_nodes = rebuilt;
+	for (auto const node : g.nodes()) {
+		with_nodes.insert_node(node);
+	}
+	CHECK(with_nodes == g);
+	CHECK((rebuilt == g) == (rebuilt.node_count() == g.node_count()));
+}
@@ -0,0 +1,232 @@
+#include "gdwg/graph_io.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	auto make_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"a", "b", "c d", "e"};
+		g.insert_edge("a", "b", 3);
+		g.insert_edge("a", "b", 1);
+		g.insert_edge("a", "c d", 2);
+		g.insert_edge("c d", "a", 4);
+		g.insert_edge("c d", "c d", -5);
+		return g;
+	}
+
+	// Returns a graph with nodes nodes and about edges random edges.
+	auto make_random_graph(int nodes, int edges) -> gdwg::graph<int, double> {
+		auto engine = std::mt19937{42};
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 1000);
+		auto batch = std::vector<gdwg::graph<int, double>::value_type>{};
+		for (auto i = 0; i < edges; ++i) {
+			batch.push_back({node(engine), node(engine), weight(engine) / 8.0});
+		}
+		auto g = gdwg::graph<int, double>::from_edges(batch.begin(), batch.end());
+		g.insert_node(nodes);
+		return g;
+	}
+
+	template<typename N, typename E>
+	auto dump(gdwg::graph<N, E> const& g) -> std::string {
+		auto os = std::ostringstream{};
+		os << g;
+		return os.str();
+	}
+} // namespace
+
+TEST_CASE("Reading dumps (operator>>, read_graph())") {
+	SECTION("operator>> reads back what operator<< wrote") {
+		auto const& g = make_graph();
+		auto is = std::istringstream(dump(g));
+		auto h = gdwg::graph<std::string, int>{"z"};
+		CHECK(is >> h);
+		CHECK(h == g);
+	}
+
+	SECTION("Nodes that start with an edge line's indent round trip") {
+		auto g = gdwg::graph<std::string, int>{"  a", "  b (", "c"};
+		g.insert_edge("  a", "c", 1);
+		g.insert_edge("c", "  a", 2);
+		g.insert_edge("  b (", "  b (", 3);
+		for (auto const threads : {1U, 4U}) {
+			auto is = std::istringstream(dump(g));
+			CHECK(gdwg::read_graph<std::string, int>(is, gdwg::graph_format::dump, threads) == g);
+		}
+	}
+
+	SECTION("Edge lines that look like headers are split between threads and rounds") {
+		auto g = gdwg::graph<std::string, std::string>{"a", "b", "c", "  b"};
+		for (auto i = 0; i < 6; ++i) {
+			g.insert_edge("a", "b", "w" + std::to_string(i) + " (");
+		}
+		g.insert_edge("c", "  b", "x (");
+		for (auto const threads : {1U, 2U, 3U, 4U, 5U, 6U, 16U}) {
+			auto is = std::istringstream(dump(g));
+			CHECK(gdwg::read_graph<std::string, std::string>(is, gdwg::graph_format::dump, threads)
+			      == g);
+		}
+
+		// over 1 MiB of such lines in one block, so it also spans rounds; the weights are added in
+		// sorted order so building the graph needs no sort
+		auto batch = std::vector<gdwg::graph<std::string, std::string>::value_type>{};
+		for (auto i = 0; i < 100000; ++i) {
+			batch.push_back({"  a", "b", std::to_string(100000 + i) + " ("});
+		}
+		auto const& big = gdwg::graph<std::string, std::string>::from_edges(batch.begin(), batch.end());
+		for (auto const threads : {1U, 3U}) {
+			auto is = std::istringstream(dump(big));
+			CHECK(gdwg::read_graph<std::string, std::string>(is, gdwg::graph_format::dump, threads)
+			      == big);
+		}
+	}
+
+	SECTION("Empty graphs round trip") {
+		auto is = std::istringstream("");
+		auto h = gdwg::graph<std::string, int>{"z"};
+		CHECK(is >> h);
+		CHECK(h.empty());
+	}
+
+	SECTION("Blocks split between threads and rounds are put back together") {
+		// about 1.5 MiB of text, so more than one round even on a single thread
+		auto const& g = make_random_graph(2000, 120000);
+		auto const text = dump(g);
+		for (auto const threads : {1U, 3U, 8U}) {
+			auto is = std::istringstream(text);
+			CHECK(gdwg::read_graph<int, double>(is, gdwg::graph_format::dump, threads) == g);
+		}
+	}
+
+	SECTION("Malformed input is reported with its line") {
+		auto is = std::istringstream("a (\n  b | 1\n)\nb (\n  a 2\n)\n");
+		CHECK_THROWS_WITH((gdwg::read_graph<std::string, int>(is)),
+		                  "Cannot call gdwg::read_graph on malformed input at line 5");
+
+		for (auto const* const text : {"  a | 1\n", "a (\n  b | x\n)\n", "a (\nb (\n)\n", "a (\n"}) {
+			auto bad = std::istringstream(text);
+			CHECK_THROWS_AS((gdwg::read_graph<std::string, int>(bad)), std::runtime_error);
+		}
+	}
+
+	SECTION("Unweighted graphs round trip without a weight field") {
+		auto g = gdwg::graph<int, gdwg::unweighted>{1, 2, 3, 4};
+		g.insert_edge(1, 2);
+		g.insert_edge(2, 1);
+		g.insert_edge(3, 3);
+		auto os = std::ostringstream{};
+		os << g;
+		CHECK(os.str() == "1 (\n  2\n)\n2 (\n  1\n)\n3 (\n  3\n)\n4 (\n)\n");
+		auto is = std::istringstream(os.str());
+		auto h = gdwg::graph<int, gdwg::unweighted>{};
+		CHECK(is >> h);
+		CHECK(g == h);
+	}
+
+	SECTION("Character nodes round trip as characters, not numbers") {
+		auto g = gdwg::graph<char, int>{'a', 'b', '7'};
+		g.insert_edge('a', 'b', 1);
+		g.insert_edge('7', 'a', 2);
+		CHECK(dump(g) == "7 (\n  a | 2\n)\na (\n  b | 1\n)\nb (\n)\n");
+		auto is = std::istringstream(dump(g));
+		auto h = gdwg::graph<char, int>{};
+		CHECK(is >> h);
+		CHECK(h == g);
+
+		auto bad = std::istringstream("ab (\n)\n");
+		CHECK_THROWS_AS((gdwg::read_graph<char, int>(bad)), std::runtime_error);
+	}
+
+	SECTION("operator>> leaves the graph unchanged and sets failbit on malformed input") {
+		auto is = std::istringstream("a (\n  b | 1\n");
+		auto h = gdwg::graph<std::string, int>{"z"};
+		CHECK_FALSE(is >> h);
+		CHECK(h.nodes() == std::vector<std::string>{"z"});
+	}
+}
+
+TEST_CASE("Edge lists (write_edge_list(), read_graph())") {
+	SECTION("Edge lists round trip, apart from nodes without edges") {
+		auto const& g = make_random_graph(500, 3000);
+		auto os = std::ostringstream{};
+		gdwg::write_edge_list(g, os);
+		for (auto const threads : {1U, 4U}) {
+			auto is = std::istringstream(os.str());
+			auto h = gdwg::read_graph<int, double>(is, gdwg::graph_format::edge_list, threads);
+			h.insert_node(500);
+			CHECK(h == g);
+		}
+	}
+
+	SECTION("Comments, blank lines and repeated edges are skipped") {
+		auto is = std::istringstream("# a comment\n1 2 0.5\n\n  2\t3 1.5  \n1 2 0.5");
+		auto const& h = gdwg::read_graph<int, double>(is, gdwg::graph_format::edge_list);
+		CHECK(h.nodes() == std::vector{1, 2, 3});
+		CHECK(h.edge_count() == 2);
+		CHECK(h.weights(2, 3) == std::vector{1.5});
+	}
+
+	SECTION("Lines without exactly three fields are malformed") {
+		for (auto const* const text : {"1 2\n", "1 2 3 4\n", "1 2 x\n"}) {
+			auto is = std::istringstream(text);
+			CHECK_THROWS_WITH((gdwg::read_graph<int, double>(is, gdwg::graph_format::edge_list)),
+			                  "Cannot call gdwg::read_graph on malformed input at line 1");
+		}
+	}
+
+	SECTION("Edge lists of unweighted graphs have two fields") {
+		auto g = gdwg::graph<int, gdwg::unweighted>{1, 2, 3};
+		g.insert_edge(1, 2);
+		g.insert_edge(3, 1);
+		auto os = std::ostringstream{};
+		gdwg::write_edge_list(g, os);
+		CHECK(os.str() == "1 2\n3 1\n");
+		auto is = std::istringstream(os.str());
+		CHECK(gdwg::read_graph<int, gdwg::unweighted>(is, gdwg::graph_format::edge_list) == g);
+
+		auto bad = std::istringstream("1 2 3\n");
+		CHECK_THROWS_AS((gdwg::read_graph<int, gdwg::unweighted>(bad, gdwg::graph_format::edge_list)),
+		                std::runtime_error);
+	}
+
+	SECTION("Nodes that can't be read back as one field aren't written") {
+		auto os = std::ostringstream{};
+		CHECK_THROWS_WITH(gdwg::write_edge_list(make_graph(), os),
+		                  "Cannot call gdwg::write_edge_list on a graph whose nodes or weights "
+		                  "can't be written as single fields");
+
+		for (auto const* const src : {"", "#a", "a\tb"}) {
+			auto g = gdwg::graph<std::string, int>{src, "b"};
+			g.insert_edge(src, "b", 1);
+			CHECK_THROWS_AS(gdwg::write_edge_list(g, os), std::runtime_error);
+		}
+
+		auto g = gdwg::graph<std::string, int>{"a#", "b"};
+		g.insert_edge("b", "a#", 1);
+		os.str({});
+		gdwg::write_edge_list(g, os);
+		auto is = std::istringstream(os.str());
+		CHECK(gdwg::read_graph<std::string, int>(is, gdwg::graph_format::edge_list) == g);
+	}
+
+	SECTION("Files are read on several threads") {
+		auto const& g = make_random_graph(500, 3000);
+		auto const path = std::filesystem::temp_directory_path() / "gdwg_graph_io_test1.txt";
+		{
+			auto os = std::ofstream(path);
+			os << g;
+		}
+		CHECK(gdwg::read_graph<int, double>(path, gdwg::graph_format::dump, 4) == g);
+		std::filesystem::remove(path);
+
+		CHECK_THROWS_WITH((gdwg::read_graph<int, double>(path)),
+		                  "Cannot call gdwg::read_graph on a file that can't be opened");
+	}
+}
@@ -14,6 +14,8 @@ fails. This also makes it easier to check if a function is working properly.
 
 #include <catch2/catch.hpp>
 
+#include <random>
+
 TEST_CASE("basic test") {
 	// This will not compile straight away
 	auto g = gdwg::graph<int, std::string>{};
@@ -158,6 +160,34 @@ TEST_CASE("Copy constructor") {
 	CHECK(g2 == g1);
 }
 
+TEST_CASE("Copies are independent of the original") {
+	auto g1 = gdwg::graph<std::string, int>{"c", "a", "b"};
+	REQUIRE(g1.insert_edge("a", "b", 2));
+	REQUIRE(g1.insert_edge("a", "b", 1));
+	REQUIRE(g1.insert_edge("b", "b", 3));
+	REQUIRE(g1.insert_edge("c", "a", 4));
+	REQUIRE(g1.insert_edge("c", "b", 5));
+
+	auto g2 = g1;
+	REQUIRE(g2 == g1);
+	CHECK(g2.edge_count() == 5);
+	CHECK(g2.in_degree("b") == 4);
+	CHECK(g2.weights("a", "b") == std::vector{1, 2});
+
+	// the copy's incoming edges must refer to its own nodes
+	REQUIRE(g2.erase_node("b"));
+	CHECK(g2.connections("a").empty());
+	CHECK(g2.connections("c") == std::vector<std::string>{"a"});
+	CHECK(g2.edge_count() == 1);
+	g2.merge_replace_node("a", "c");
+	CHECK(g2.weights("c", "c") == std::vector{4});
+
+	CHECK(g1.nodes() == std::vector<std::string>{"a", "b", "c"});
+	CHECK(g1.edge_count() == 5);
+	CHECK(g1.weights("c", "b") == std::vector{5});
+	CHECK(g1.in_degree("a") == 1);
+}
+
 TEST_CASE("Copy assignment") {
 	auto g1 = gdwg::graph<int, int>{1, 2};
 	REQUIRE(g1.insert_edge(1, 2, 1));
@@ -180,6 +210,136 @@ TEST_CASE("Copy assignment") {
 	CHECK(g2 == g1);
 }
 
+namespace {
+	// Forwards to the default resource, keeping track of how many bytes are still allocated.
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		[[nodiscard]] auto bytes_in_use() const noexcept -> std::size_t {
+			return bytes_in_use_;
+		}
+
+	private:
+		std::size_t bytes_in_use_ = 0;
+
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			bytes_in_use_ += bytes;
+			return std::pmr::get_default_resource()->allocate(bytes, alignment);
+		}
+
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			bytes_in_use_ -= bytes;
+			std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+		}
+
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override {
+			return this == &other;
+		}
+	};
+} // namespace
+
+TEST_CASE("Memory resource constructors") {
+	auto resource = counting_resource{};
+
+	SECTION("Nodes and edges are allocated from the resource and returned to it") {
+		{
+			auto g = gdwg::graph<std::string, int>({"a", "b", "c"}, &resource);
+			REQUIRE(g.insert_edge("a", "b", 1));
+			REQUIRE(g.insert_edge("c", "a", 2));
+			CHECK(g.resource() == &resource);
+			CHECK(resource.bytes_in_use() > 0);
+
+			REQUIRE(g.erase_node("a"));
+			g.clear();
+			CHECK(resource.bytes_in_use() == 0);
+
+			REQUIRE(g.insert_node("d"));
+			CHECK(resource.bytes_in_use() > 0);
+		}
+		CHECK(resource.bytes_in_use() == 0);
+	}
+
+	SECTION("Node values that take an allocator allocate from the resource") {
+		auto g = gdwg::graph<std::pmr::string, int>(&resource);
+		REQUIRE(g.insert_node("a"));
+		auto const short_node = resource.bytes_in_use();
+		auto const value = std::pmr::string(1000, 'x');
+		REQUIRE(g.insert_node(value));
+		CHECK(resource.bytes_in_use() - short_node >= short_node + value.size());
+
+		// nodes are stored in place, so references to them survive later insertions
+		REQUIRE(g.insert_edge(value, value, 1));
+		auto const* const stored = &*g.neighbours(value).begin();
+		for (auto i = std::size_t{1}; i <= 64; ++i) {
+			REQUIRE(g.insert_node(std::pmr::string(i, 'b')));
+		}
+		CHECK(&*g.neighbours(value).begin() == stored);
+		CHECK(*stored == value);
+	}
+
+	SECTION("Every constructor accepts a resource") {
+		auto const nodes = std::vector<int>{1, 2, 3};
+		auto const edges = std::vector<gdwg::graph<int, int>::value_type>{{1, 2, 1}, {2, 3, 1}};
+		CHECK(gdwg::graph<int, int>(&resource).resource() == &resource);
+		CHECK(gdwg::graph<int, int>(nodes.begin(), nodes.end(), &resource).resource() == &resource);
+		CHECK(gdwg::graph<int, int>::from_edges(edges.begin(), edges.end(), &resource).resource()
+		      == &resource);
+		CHECK(resource.bytes_in_use() == 0);
+	}
+
+	SECTION("Copies use the default resource unless one is given") {
+		auto g = gdwg::graph<int, int>({1, 2}, &resource);
+		REQUIRE(g.insert_edge(1, 2, 1));
+
+		auto const copy = g;
+		CHECK(copy.resource() == std::pmr::get_default_resource());
+		CHECK(copy == g);
+
+		auto const arena_copy = gdwg::graph<int, int>(copy, &resource);
+		CHECK(arena_copy.resource() == &resource);
+		CHECK(arena_copy == g);
+	}
+
+	SECTION("Copy assignment keeps the target's resource") {
+		auto g = gdwg::graph<int, int>({1, 2}, &resource);
+		auto const other = gdwg::graph<int, int>{3};
+		g = other;
+		CHECK(g.resource() == &resource);
+		CHECK(g.nodes() == std::vector{3});
+	}
+
+	SECTION("Moves take the resource along with the nodes and edges") {
+		auto g = gdwg::graph<int, int>({1, 2}, &resource);
+		REQUIRE(g.insert_edge(1, 2, 1));
+		auto const iter = g.begin();
+
+		auto other = gdwg::graph<int, int>{3};
+		other = std::move(g);
+		CHECK(other.resource() == &resource);
+		CHECK(iter == other.begin());
+		CHECK(other.is_connected(1, 2));
+		// NOLINTNEXTLINE(bugprone-use-after-move)
+		CHECK(g.empty());
+
+		auto moved = std::move(other);
+		CHECK(moved.resource() == &resource);
+		CHECK(moved.is_connected(1, 2));
+	}
+
+	SECTION("Graphs can be backed by a monotonic arena") {
+		auto arena = std::pmr::monotonic_buffer_resource(&resource);
+		auto g = gdwg::graph<int, int>(&arena);
+		for (auto i = 0; i < 64; ++i) {
+			REQUIRE(g.insert_node(i));
+		}
+		for (auto i = 0; i < 64; ++i) {
+			REQUIRE(g.insert_edge(i, (i * 7) % 64, i));
+		}
+		CHECK(g.edge_count() == 64);
+		CHECK(g.weights(1, 7) == std::vector{1});
+	}
+}
+
 TEST_CASE("Node insertion (insert_node())") {
 	auto g = gdwg::graph<std::string, int>{};
 	REQUIRE(g.empty());
@@ -232,6 +392,20 @@ TEST_CASE("Edge insertion (insert_edge())") {
 		CHECK(g.find(1, 3, "a") != g.end());
 	}
 
+	SECTION("Edges are ordered by destination value regardless of insertion order") {
+		auto h = gdwg::graph<std::string, int>{"c", "b", "a"};
+		REQUIRE(h.insert_edge("a", "c", 1));
+		REQUIRE(h.insert_edge("a", "a", 2));
+		REQUIRE(h.insert_edge("a", "b", 3));
+		REQUIRE(h.insert_edge("a", "b", 1));
+		CHECK(h.connections("a") == std::vector<std::string>{"a", "b", "c"});
+		CHECK(h.weights("a", "b") == std::vector{1, 3});
+
+		auto out = std::ostringstream{};
+		out << h;
+		CHECK(out.str() == "a (\n  a | 2\n  b | 1\n  b | 3\n  c | 1\n)\nb (\n)\nc (\n)\n");
+	}
+
 	SECTION("insert_edge() throws if src or dst nodes do not exist in graph") {
 		auto const& exception_msg = "Cannot call gdwg::graph<N, E>::insert_edge when either src or "
 		                            "dst node does not "
@@ -246,6 +420,50 @@ TEST_CASE("Edge insertion (insert_edge())") {
 	}
 }
 
+TEST_CASE("Bulk edge insertion (insert_edges())") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	REQUIRE(g.insert_edge(1, 2, 5));
+
+	SECTION("Unsorted batches with duplicates are inserted once") {
+		auto const& batch = std::vector<gdwg::graph<int, int>::value_type>{
+		   {3, 1, 2}, {1, 2, 5}, {1, 3, 1}, {3, 1, 2}, {1, 2, 4}, {2, 2, 7}};
+		CHECK(g.insert_edges(batch.begin(), batch.end()) == 4);
+		CHECK(g.weights(1, 2) == std::vector{4, 5});
+		CHECK(g.weights(1, 3) == std::vector{1});
+		CHECK(g.weights(2, 2) == std::vector{7});
+		CHECK(g.weights(3, 1) == std::vector{2});
+
+		// incoming edges are recorded, so erasing a destination removes the bulk inserted edges
+		REQUIRE(g.erase_node(2));
+		CHECK(g.connections(1) == std::vector{3});
+	}
+
+	SECTION("insert_edges() throws and adds nothing if src or dst nodes do not exist") {
+		auto const& batch = std::vector<gdwg::graph<int, int>::value_type>{{1, 3, 1}, {1, 4, 1}};
+		CHECK_THROWS_WITH(g.insert_edges(batch.begin(), batch.end()),
+		                  "Cannot call gdwg::graph<N, E>::insert_edges when either src or dst node "
+		                  "does not exist");
+		CHECK_FALSE(g.is_connected(1, 3));
+	}
+}
+
+TEST_CASE("Bulk construction (from_edges())") {
+	auto const& batch = std::vector<gdwg::graph<std::string, int>::value_type>{
+	   {"c", "a", 1}, {"a", "b", 2}, {"a", "b", 1}, {"c", "a", 1}, {"b", "d", 3}};
+	auto const& g = gdwg::graph<std::string, int>::from_edges(batch.begin(), batch.end());
+
+	auto expected = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	REQUIRE(expected.insert_edge("c", "a", 1));
+	REQUIRE(expected.insert_edge("a", "b", 2));
+	REQUIRE(expected.insert_edge("a", "b", 1));
+	REQUIRE(expected.insert_edge("b", "d", 3));
+	CHECK(g == expected);
+	CHECK(g.nodes() == std::vector<std::string>{"a", "b", "c", "d"});
+
+	auto const& empty = std::vector<gdwg::graph<std::string, int>::value_type>{};
+	CHECK(gdwg::graph<std::string, int>::from_edges(empty.begin(), empty.end()).empty());
+}
+
 TEST_CASE("Node replacement (replace_node())") {
 	auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
 	REQUIRE(g.nodes().size() == 3);
@@ -453,6 +671,129 @@ TEST_CASE("Node erasure (erase_node())") {
 	}
 }
 
+TEST_CASE("Incoming edges stay consistent across modifiers") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	REQUIRE(g.insert_edge(1, 2, 1));
+	REQUIRE(g.insert_edge(1, 2, 2));
+	REQUIRE(g.insert_edge(3, 2, 1));
+	REQUIRE(g.insert_edge(2, 2, 5));
+
+	SECTION("Erasing one of several parallel edges keeps the others reachable") {
+		REQUIRE(g.erase_edge(1, 2, 1));
+		g.merge_replace_node(2, 3);
+		CHECK(g.weights(1, 3) == std::vector{2});
+		CHECK(g.weights(3, 3) == std::vector{1, 5});
+	}
+
+	SECTION("Edges erased through an iterator are not revisited") {
+		g.erase_edge(g.find(3, 2, 1));
+		REQUIRE(g.erase_node(2));
+		CHECK(g.connections(1).empty());
+		CHECK(g.connections(3).empty());
+		CHECK(g.begin() == g.end());
+	}
+
+	SECTION("Erasing a node with a self loop removes every incident edge") {
+		REQUIRE(g.erase_node(2));
+		CHECK(g.nodes() == std::vector{1, 3});
+		CHECK(g.begin() == g.end());
+		REQUIRE(g.insert_node(2));
+		CHECK_FALSE(g.is_connected(1, 2));
+		CHECK_FALSE(g.is_connected(3, 2));
+	}
+
+	SECTION("Cleared graphs can be rebuilt") {
+		g.clear();
+		REQUIRE(g.insert_node(1));
+		REQUIRE(g.insert_node(2));
+		REQUIRE(g.insert_edge(1, 2, 1));
+		REQUIRE(g.erase_node(1));
+		CHECK(g.nodes() == std::vector{2});
+		CHECK(g.begin() == g.end());
+	}
+}
+
+TEST_CASE("Node and edge counts (node_count(), edge_count(), out_degree(), in_degree())") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	REQUIRE(g.insert_edge(1, 2, 1));
+	REQUIRE(g.insert_edge(1, 2, 2));
+	REQUIRE(g.insert_edge(3, 2, 1));
+	REQUIRE(g.insert_edge(2, 2, 5));
+	REQUIRE(g.insert_edge(2, 1, 4));
+
+	// Checks every count against a full recount of the graph.
+	auto const check_counts = [](gdwg::graph<int, int> const& graph) {
+		CHECK(graph.node_count() == graph.nodes().size());
+		CHECK(graph.edge_count()
+		      == static_cast<std::size_t>(std::distance(graph.begin(), graph.end())));
+		for (auto const node : graph.nodes()) {
+			auto out = std::size_t{0};
+			auto in = std::size_t{0};
+			for (auto const& [from, to, _] : graph) {
+				out += from == node ? 1 : 0;
+				in += to == node ? 1 : 0;
+			}
+			CHECK(graph.out_degree(node) == out);
+			CHECK(graph.in_degree(node) == in);
+		}
+	};
+
+	SECTION("Counts reflect inserted nodes and edges") {
+		CHECK(g.node_count() == 3);
+		CHECK(g.edge_count() == 5);
+		CHECK(g.out_degree(1) == 2);
+		CHECK(g.in_degree(2) == 4);
+		CHECK(g.out_degree(3) == 1);
+		CHECK(g.in_degree(3) == 0);
+		CHECK_FALSE(g.insert_edge(1, 2, 1));
+		check_counts(g);
+	}
+
+	SECTION("Counts follow every modifier") {
+		REQUIRE(g.erase_edge(1, 2, 1));
+		check_counts(g);
+		g.erase_edge(g.begin());
+		check_counts(g);
+		auto const batch = std::vector<gdwg::graph<int, int>::value_type>{{1, 3, 1}, {3, 3, 2}};
+		REQUIRE(g.insert_edges(batch.begin(), batch.end()) == 2);
+		check_counts(g);
+		g.merge_replace_node(2, 3);
+		check_counts(g);
+		REQUIRE(g.replace_node(3, 4));
+		check_counts(g);
+		REQUIRE(g.erase_node(4));
+		check_counts(g);
+		g.erase_edge(g.begin(), g.end());
+		check_counts(g);
+		g.clear();
+		CHECK(g.node_count() == 0);
+		CHECK(g.edge_count() == 0);
+	}
+
+	SECTION("Counts are copied and moved with the graph") {
+		auto copy = g;
+		CHECK(copy.edge_count() == 5);
+		auto moved = std::move(g);
+		CHECK(moved.edge_count() == 5);
+		CHECK(g.edge_count() == 0);
+		g = std::move(moved);
+		CHECK(g.edge_count() == 5);
+		CHECK(moved.edge_count() == 0);
+		check_counts(g);
+	}
+
+	SECTION("Degrees throw on missing nodes") {
+		CHECK_THROWS_MATCHES(g.out_degree(4),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::out_degree if "
+		                                              "value doesn't exist in the graph"));
+		CHECK_THROWS_MATCHES(g.in_degree(4),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::in_degree if "
+		                                              "value doesn't exist in the graph"));
+	}
+}
+
 TEST_CASE("Edge erasure (erase_edge(src, dst, weight))") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
 	REQUIRE(g.nodes().size() == 3);
@@ -569,6 +910,47 @@ TEST_CASE("Edge erasure (erase_edge(iterator1, iterator2))") {
 
 		CHECK(g.erase_edge(last, g.end()) == g.end());
 	}
+
+	SECTION("Edges can be erased from the middle of a node's edges") {
+		REQUIRE(g.insert_edge(1, 2, 2));
+		REQUIRE(g.insert_edge(1, 2, 3));
+		REQUIRE(g.insert_edge(1, 3, 1));
+
+		auto const& next = g.erase_edge(g.find(1, 2, 2), g.find(1, 3, 1));
+		REQUIRE(next != g.end());
+		auto const& [src, dst, weight] = *next;
+		CHECK(src == 1);
+		CHECK(dst == 3);
+		CHECK(weight == 1);
+		CHECK(g.weights(1, 2) == std::vector{1});
+	}
+
+	SECTION("Edges can be erased across several sources, cutting runs on both ends") {
+		REQUIRE(g.insert_edge(1, 2, 2));
+		REQUIRE(g.insert_edge(1, 3, 1));
+		REQUIRE(g.insert_edge(2, 2, 1));
+		REQUIRE(g.insert_edge(2, 3, 2));
+		REQUIRE(g.insert_edge(3, 1, 2));
+		REQUIRE(g.insert_edge(3, 1, 3));
+
+		auto const& next = g.erase_edge(g.find(1, 2, 2), g.find(3, 1, 3));
+		REQUIRE(next != g.end());
+		auto const& [src, dst, weight] = *next;
+		CHECK(src == 3);
+		CHECK(dst == 1);
+		CHECK(weight == 3);
+
+		CHECK(g.weights(1, 2) == std::vector{1});
+		CHECK_FALSE(g.is_connected(1, 3));
+		CHECK(g.out_degree(2) == 0);
+		CHECK(g.weights(3, 1) == std::vector{3});
+		CHECK(g.edge_count() == 2);
+		CHECK(g.in_degree(1) == 1);
+		CHECK(g.in_degree(2) == 1);
+		CHECK(g.in_degree(3) == 0);
+		CHECK(g.erase_node(2));
+		CHECK(g.edge_count() == 1);
+	}
 }
 
 TEST_CASE("Graph clearing (clear())") {
@@ -706,6 +1088,16 @@ TEST_CASE("Edge accessor (find())") {
 		CHECK(weight3 == 1);
 	}
 
+	SECTION("find() points at the matching edge rather than the first edge of src") {
+		REQUIRE(g.insert_edge(1, 2, 2));
+		REQUIRE(g.insert_edge(1, 3, 1));
+		auto const& [src, dst, weight] = *g.find(1, 3, 1);
+		CHECK(src == 1);
+		CHECK(dst == 3);
+		CHECK(weight == 1);
+		CHECK(std::next(g.find(1, 2, 1)) == g.find(1, 2, 2));
+	}
+
 	SECTION("find() returns end() if a given edge does not exist") {
 		// edge 1->2 exists but different weight
 		CHECK(g.find(1, 2, 3) == g.end());
@@ -748,6 +1140,125 @@ TEST_CASE("Node connections accessor (connections())") {
 	}
 }
 
+TEST_CASE("Edge range views (out_edges(), neighbours(), weights_view())") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	REQUIRE(g.insert_edge("a", "c", 2));
+	REQUIRE(g.insert_edge("a", "b", 3));
+	REQUIRE(g.insert_edge("a", "b", 1));
+	REQUIRE(g.insert_edge("a", "a", 4));
+	REQUIRE(g.insert_edge("c", "b", 5));
+
+	SECTION("out_edges() visits every outgoing edge in order") {
+		auto res = std::vector<std::pair<std::string, int>>{};
+		for (auto const& [to, weight] : g.out_edges("a")) {
+			res.emplace_back(to, weight);
+		}
+		CHECK(res == std::vector<std::pair<std::string, int>>{{"a", 4}, {"b", 1}, {"b", 3}, {"c", 2}});
+		CHECK(g.out_edges("d").empty());
+	}
+
+	SECTION("neighbours() visits each connected node once") {
+		static_assert(std::forward_iterator<gdwg::graph<std::string, int>::neighbour_iterator>);
+		auto const view = g.neighbours("a");
+		CHECK(std::vector<std::string>(view.begin(), view.end())
+		      == std::vector<std::string>{"a", "b", "c"});
+		CHECK(std::ranges::distance(g.neighbours("c")) == 1);
+		CHECK(g.neighbours("d").empty());
+	}
+
+	SECTION("weights_view() visits the weights of one destination") {
+		auto const view = g.weights_view("a", "b");
+		static_assert(std::is_same_v<decltype(view), std::span<int const> const>);
+		CHECK(std::vector<int>(view.begin(), view.end()) == std::vector{1, 3});
+		CHECK(g.weights_view("b", "a").empty());
+		CHECK(g.weights_view("a", "d").empty());
+	}
+
+	SECTION("Views read the stored edges without copying them") {
+		auto const& first = *g.weights_view("c", "b").begin();
+		auto const [to, weight] = *g.out_edges("c").begin();
+		CHECK(&first == &weight);
+		CHECK(&*g.neighbours("c").begin() == &to);
+	}
+
+	SECTION("Views throw on missing nodes") {
+		CHECK_THROWS_WITH(g.out_edges("e"),
+		                  "Cannot call gdwg::graph<N, E>::out_edges if src doesn't exist in the "
+		                  "graph");
+		CHECK_THROWS_WITH(g.neighbours("e"),
+		                  "Cannot call gdwg::graph<N, E>::neighbours if src doesn't exist in the "
+		                  "graph");
+		CHECK_THROWS_WITH(g.weights_view("a", "e"),
+		                  "Cannot call gdwg::graph<N, E>::weights_view if src or dst node don't "
+		                  "exist in the graph");
+	}
+}
+
+TEST_CASE("Parallel edges are grouped by destination") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	for (auto weight = 0; weight < 100; ++weight) {
+		REQUIRE(g.insert_edge(1, 2, 99 - weight));
+		REQUIRE(g.insert_edge(1, 3, weight));
+	}
+	REQUIRE(g.insert_edge(1, 1, 0));
+	REQUIRE(g.weights_view(1, 2).size() == 100);
+	REQUIRE(std::ranges::is_sorted(g.weights_view(1, 2)));
+	CHECK(g.connections(1) == std::vector{1, 2, 3});
+	CHECK(g.out_degree(1) == 201);
+	CHECK(g.in_degree(2) == 100);
+
+	SECTION("Erasing a weight leaves the other runs as they were") {
+		REQUIRE(g.erase_edge(1, 2, 50));
+		CHECK_FALSE(g.erase_edge(1, 2, 50));
+		CHECK(g.weights(1, 2).size() == 99);
+		CHECK(g.weights(1, 1) == std::vector{0});
+		CHECK(g.weights_view(1, 3).front() == 0);
+		CHECK(g.weights_view(1, 3).back() == 99);
+		CHECK(g.in_degree(2) == 99);
+	}
+
+	SECTION("Erasing the last weight of a run removes its destination") {
+		REQUIRE(g.erase_edge(1, 1, 0));
+		CHECK_FALSE(g.is_connected(1, 1));
+		CHECK(g.connections(1) == std::vector{2, 3});
+		CHECK(g.edge_count() == 200);
+	}
+
+	SECTION("Iterators cross from one run to the next") {
+		auto const last_to_2 = g.find(1, 2, 99);
+		auto const first_to_3 = g.find(1, 3, 0);
+		CHECK(std::next(last_to_2) == first_to_3);
+		CHECK(std::prev(first_to_3) == last_to_2);
+		CHECK((*std::prev(g.find(1, 2, 0))).to == 1);
+
+		// the operands of == are unsequenced, so each edge is erased before the next is found
+		auto next = g.erase_edge(last_to_2);
+		CHECK(next == g.find(1, 3, 0));
+		next = g.erase_edge(g.find(1, 1, 0));
+		CHECK(next == g.find(1, 2, 0));
+		CHECK(std::distance(g.begin(), g.end()) == 199);
+		CHECK(std::distance(g.begin(), g.end()) == static_cast<std::ptrdiff_t>(g.edge_count()));
+	}
+
+	SECTION("bool weights are packed into bits, but read the same way") {
+		auto flags = gdwg::graph<int, bool>{1, 2};
+		REQUIRE(flags.insert_edge(1, 2, true));
+		REQUIRE(flags.insert_edge(1, 2, false));
+		CHECK(flags.weights(1, 2) == std::vector{false, true});
+		CHECK(std::ranges::equal(flags.weights_view(1, 2), std::vector{false, true}));
+		auto const [to, weight] = *std::next(flags.out_edges(1).begin());
+		CHECK(to == 2);
+		CHECK(weight);
+	}
+
+	SECTION("Merging nodes merges their runs") {
+		g.merge_replace_node(3, 2);
+		CHECK(g.weights_view(1, 2).size() == 100);
+		CHECK(g.connections(1) == std::vector{1, 2});
+		CHECK(g.edge_count() == 101);
+	}
+}
+
 TEST_CASE("Begin iterator (begin())") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
 	REQUIRE(g.nodes().size() == 3);
@@ -822,6 +1333,25 @@ TEST_CASE("Equality testing (operator==)") {
 		CHECK(g1 != g2);
 	}
 
+	SECTION("Graphs with the same edge counts per node but different edges are not equal") {
+		auto g2 = gdwg::graph<int, int>{1, 2, 3};
+		REQUIRE(g2.insert_edge(1, 3, 1));
+		REQUIRE(g2.insert_edge(3, 1, 1));
+		CHECK(g1 != g2);
+
+		auto g3 = gdwg::graph<int, int>{1, 2, 3};
+		REQUIRE(g3.insert_edge(1, 2, 2));
+		REQUIRE(g3.insert_edge(3, 1, 1));
+		CHECK(g1 != g3);
+	}
+
+	SECTION("Graphs with a different number of nodes are not equal") {
+		auto g2 = g1;
+		REQUIRE(g2.insert_node(4));
+		CHECK(g1 != g2);
+		CHECK(g2 != g1);
+	}
+
 	SECTION("Empty graphs are equal") {
 		auto const& g2 = gdwg::graph<int, int>{};
 		REQUIRE(g2.nodes().empty());
@@ -942,6 +1472,42 @@ TEST_CASE("Graph extractor (operator<<)") {
 		oss << g;
 		CHECK(oss.str().empty());
 	}
+
+	SECTION("Extractor output matches inserting each field, whatever the stream's format") {
+		auto g = gdwg::graph<double, float>{0.1, -3.25, 1e20, 1.0 / 3};
+		g.insert_edge(0.1, 1e20, 2.5F);
+		g.insert_edge(0.1, 1.0 / 3, -1e-7F);
+		g.insert_edge(1e20, 1e20, 123456789.0F);
+		auto h = gdwg::graph<char, long>{'a', 'b'};
+		h.insert_edge('a', 'b', -42);
+		h.insert_edge('b', 'b', 1L << 40);
+
+		auto const check = [](auto const& graph, auto const& configure) {
+			auto expected = std::ostringstream{};
+			configure(expected);
+			for (auto const& node : graph.nodes()) {
+				expected << node << " (\n";
+				for (auto const& [to, weight] : graph.out_edges(node)) {
+					expected << "  " << to << " | " << weight << "\n";
+				}
+				expected << ")\n";
+			}
+			auto out = std::ostringstream{};
+			configure(out);
+			out << graph;
+			CHECK(out.str() == expected.str());
+		};
+		for (auto const& configure : std::vector<void (*)(std::ostream&)>{
+		        [](std::ostream&) {},
+		        [](std::ostream& os) { os.precision(17); },
+		        [](std::ostream& os) { os << std::fixed << std::showpos; },
+		        [](std::ostream& os) { os << std::hex << std::uppercase << std::scientific; },
+		        [](std::ostream& os) { os.width(8); }})
+		{
+			check(g, configure);
+			check(h, configure);
+		}
+	}
 }
 
 TEST_CASE("Iterator operators") {
@@ -1029,4 +1595,309 @@ TEST_CASE("Iterator operators") {
 		CHECK(weight3 == 1);
 		CHECK(g.find(1, 2, 1) == it);
 	}
-}
\ No newline at end of file
+}
+namespace {
+	// Node types whose graphs keep a hash index: one with a weak hash, and one whose hash collides
+	// for most values, so that probing and erasure have long runs to deal with.
+	struct indexed {
+		int value;
+		auto operator<=>(indexed const&) const = default;
+	};
+
+	struct colliding {
+		int value;
+		auto operator<=>(colliding const&) const = default;
+	};
+
+	// Applies the same random operations to a graph indexed by hash and to an ordinary graph, and
+	// checks that they always agree.
+	template<typename Node>
+	auto check_against_ordered_graph() -> void {
+		auto engine = std::mt19937{7};
+		auto value = std::uniform_int_distribution<int>(0, 199);
+		auto op = std::uniform_int_distribution<int>(0, 99);
+		auto g = gdwg::graph<Node, int>{};
+		auto expected = gdwg::graph<int, int>{};
+
+		for (auto step = 0; step < 20000; ++step) {
+			auto const a = value(engine);
+			auto const b = value(engine);
+			auto const roll = op(engine);
+			if (roll < 30) {
+				REQUIRE(g.insert_node(Node{a}) == expected.insert_node(a));
+			}
+			else if (roll < 45) {
+				REQUIRE(g.erase_node(Node{a}) == expected.erase_node(a));
+			}
+			else if (roll < 70) {
+				if (expected.is_node(a) && expected.is_node(b)) {
+					REQUIRE(g.insert_edge(Node{a}, Node{b}, a % 3) == expected.insert_edge(a, b, a % 3));
+				}
+			}
+			else if (roll < 80) {
+				if (expected.is_node(a) && expected.is_node(b)) {
+					REQUIRE(g.erase_edge(Node{a}, Node{b}, a % 3) == expected.erase_edge(a, b, a % 3));
+				}
+			}
+			else if (roll < 85) {
+				if (expected.is_node(a)) {
+					REQUIRE(g.replace_node(Node{a}, Node{b}) == expected.replace_node(a, b));
+				}
+			}
+			else if (roll < 88) {
+				if (expected.is_node(a) && expected.is_node(b)) {
+					g.merge_replace_node(Node{a}, Node{b});
+					expected.merge_replace_node(a, b);
+				}
+			}
+			else if (roll < 89) {
+				g = gdwg::graph<Node, int>(g);
+			}
+			else if (roll < 90) {
+				auto moved = std::move(g);
+				g = std::move(moved);
+			}
+			else {
+				REQUIRE(g.is_node(Node{a}) == expected.is_node(a));
+			}
+
+			if (step % 1000 == 0) {
+				auto nodes = std::vector<int>{};
+				for (auto const& node : g.nodes()) {
+					nodes.push_back(node.value);
+				}
+				REQUIRE(nodes == expected.nodes());
+				REQUIRE(g.edge_count() == expected.edge_count());
+			}
+		}
+		g.clear();
+		CHECK_FALSE(g.is_node(Node{0}));
+		CHECK(g.insert_node(Node{0}));
+	}
+} // namespace
+
+template<>
+struct gdwg::graph_traits<indexed> {
+	struct hasher {
+		auto operator()(indexed const& node) const -> std::size_t {
+			return std::hash<int>{}(node.value);
+		}
+	};
+};
+
+template<>
+struct gdwg::graph_traits<colliding> {
+	struct hasher {
+		auto operator()(colliding const& node) const -> std::size_t {
+			return static_cast<std::size_t>(node.value % 4);
+		}
+	};
+};
+
+TEST_CASE("Hash node index (graph_traits)") {
+	SECTION("An indexed graph behaves exactly like an ordinary one") {
+		check_against_ordered_graph<indexed>();
+	}
+
+	SECTION("Colliding hashes are told apart") {
+		check_against_ordered_graph<colliding>();
+	}
+
+	SECTION("Nodes are still iterated in order") {
+		auto const g = gdwg::graph<indexed, int>{indexed{3}, indexed{1}, indexed{2}};
+		CHECK(g.nodes() == std::vector<indexed>{{1}, {2}, {3}});
+	}
+}
+
+namespace {
+	// A node that can only be found by its id, since nothing converts to it.
+	struct ticket {
+		int id;
+		std::string owner;
+
+		auto operator<=>(ticket const& other) const {
+			return id <=> other.id;
+		}
+		auto operator==(ticket const& other) const -> bool {
+			return id == other.id;
+		}
+		friend auto operator<=>(ticket const& lhs, int rhs) {
+			return lhs.id <=> rhs;
+		}
+	};
+
+	// A node with a transparent hasher, so its hash index takes string_view keys as well.
+	struct symbol {
+		std::string name;
+
+		auto operator<=>(symbol const&) const = default;
+		auto operator==(symbol const&) const -> bool = default;
+		friend auto operator<=>(symbol const& lhs, std::string_view rhs) {
+			return std::string_view(lhs.name) <=> rhs;
+		}
+		friend auto operator==(symbol const& lhs, std::string_view rhs) -> bool {
+			return lhs.name == rhs;
+		}
+	};
+} // namespace
+
+template<>
+struct gdwg::graph_traits<symbol> {
+	struct hasher {
+		using is_transparent = void;
+		auto operator()(std::string_view name) const -> std::size_t {
+			return std::hash<std::string_view>{}(name);
+		}
+		auto operator()(symbol const& node) const -> std::size_t {
+			return (*this)(node.name);
+		}
+	};
+};
+
+TEST_CASE("Heterogeneous lookup (node_key)") {
+	SECTION("std::string nodes are found by std::string_view and char const*") {
+		auto g = gdwg::graph<std::string, int>{"are", "hello", "how"};
+		g.insert_edge("hello", "how", 5);
+		g.insert_edge(std::string_view("hello"), std::string_view("are"), 8);
+		g.insert_edge("hello", "are", 2);
+
+		auto const hello = std::string_view("hello");
+		char const* const are = "are";
+		CHECK(g.is_node(hello));
+		CHECK_FALSE(g.is_node(std::string_view("you")));
+		CHECK(g.is_connected(hello, are));
+		CHECK_FALSE(g.is_connected(are, hello));
+		CHECK(g.weights(hello, are) == std::vector{2, 8});
+		CHECK(g.find(hello, "how", 5) != g.end());
+		CHECK(g.find(hello, "you", 5) == g.end());
+		CHECK(g.connections(hello) == std::vector<std::string>{"are", "how"});
+		CHECK(g.out_degree(hello) == 3);
+		CHECK(g.in_degree(are) == 2);
+		CHECK(std::ranges::distance(g.out_edges(hello)) == 3);
+		CHECK(std::ranges::distance(g.neighbours(hello)) == 2);
+		CHECK(std::ranges::equal(g.weights_view(hello, are), std::vector{2, 8}));
+
+		CHECK(g.erase_edge(hello, are, 8));
+		CHECK_FALSE(g.erase_edge(hello, are, 8));
+		CHECK(g.erase_node(are));
+		CHECK(g.nodes() == std::vector<std::string>{"hello", "how"});
+		CHECK(g.edge_count() == 1);
+	}
+
+	SECTION("Missing nodes are reported as they are for N") {
+		auto g = gdwg::graph<std::string, int>{"a"};
+		CHECK_THROWS_WITH(g.insert_edge("a", std::string_view("b"), 1),
+		                  "Cannot call gdwg::graph<N, E>::insert_edge when either src or dst node "
+		                  "does not exist");
+		CHECK_THROWS_WITH(g.connections(std::string_view("b")),
+		                  "Cannot call gdwg::graph<N, E>::connections if src doesn't exist in the "
+		                  "graph");
+		CHECK_FALSE(g.erase_node("b"));
+	}
+
+	SECTION("Keys that don't convert to N are compared as they are") {
+		auto g = gdwg::graph<ticket, int>{ticket{2, "bob"}, ticket{1, "alice"}};
+		g.insert_edge(1, 2, 7);
+		CHECK(g.is_node(1));
+		CHECK_FALSE(g.is_node(3));
+		CHECK(g.weights(1, 2) == std::vector{7});
+		CHECK(g.connections(1).front().owner == "bob");
+		CHECK(g.erase_node(2));
+		CHECK(g.edge_count() == 0);
+	}
+
+	SECTION("Keys that only convert to N are converted") {
+		auto const g = gdwg::graph<std::string, int>{"a", "b"};
+		auto const a = std::string("a");
+		CHECK(g.is_node(std::cref(a)));
+		CHECK_FALSE(g.is_connected(std::cref(a), "b"));
+	}
+
+	SECTION("Arithmetic keys are converted to N, so they keep N's ordering") {
+		auto g = gdwg::graph<int, int>{-5, -1, 0, 1, 2};
+		g.insert_edge(std::size_t{1}, -1, 3);
+		CHECK(g.is_node(std::size_t{0}));
+		CHECK(g.is_node(std::size_t{1}));
+		CHECK(g.is_node(std::size_t{2}));
+		CHECK_FALSE(g.is_node(std::size_t{3}));
+		CHECK(g.is_node(1.5));
+		CHECK(g.is_connected(std::size_t{1}, -1));
+		CHECK(g.weights(1, std::int64_t{-1}) == std::vector{3});
+	}
+
+	SECTION("A transparent hasher lets the hash index take keys too") {
+		auto g = gdwg::graph<symbol, int>{symbol{"x"}, symbol{"y"}};
+		g.insert_edge(std::string_view("x"), "y", 1);
+		CHECK(g.is_node(std::string_view("y")));
+		CHECK_FALSE(g.is_node("z"));
+		CHECK(g.is_connected("x", std::string_view("y")));
+		CHECK(g.erase_node(std::string_view("x")));
+		CHECK_FALSE(g.is_node("x"));
+		CHECK(g.is_node(symbol{"y"}));
+	}
+}
+
+TEST_CASE("Unweighted graphs (gdwg::unweighted)") {
+	using graph = gdwg::graph<std::string, gdwg::unweighted>;
+	static_assert(sizeof(graph::value_type) == 2 * sizeof(std::string));
+
+	auto g = graph{"a", "b", "c"};
+	CHECK(g.insert_edge("a", "b"));
+	CHECK(g.insert_edge("a", "c"));
+	CHECK(g.insert_edge("c", "c"));
+	CHECK_FALSE(g.insert_edge("a", "b"));
+
+	SECTION("Edges are told apart by their endpoints alone") {
+		CHECK(g.edge_count() == 3);
+		CHECK(g.is_connected("a", "b"));
+		CHECK(g.connections("a") == std::vector<std::string>{"b", "c"});
+		CHECK(g.weights("a", "b").size() == 1);
+		CHECK(g.find("c", "c") != g.end());
+		CHECK(g.find("b", "a") == g.end());
+	}
+
+	SECTION("Iteration and batches leave the weight out") {
+		auto edges = std::vector<std::pair<std::string, std::string>>{};
+		for (auto const& [from, to, _] : g) {
+			edges.emplace_back(from, to);
+		}
+		CHECK(edges
+		      == std::vector<std::pair<std::string, std::string>>{{"a", "b"}, {"a", "c"}, {"c", "c"}});
+
+		auto const batch =
+		   std::vector<graph::value_type>{{"b", "a", {}}, {"b", "c", {}}, {"a", "b", {}}};
+		CHECK(g.insert_edges(batch.begin(), batch.end()) == 2);
+		CHECK(graph::from_edges(g.begin(), g.end()) == g);
+	}
+
+	SECTION("Erasing an edge needs no weight") {
+		CHECK(g.erase_edge("a", "b"));
+		CHECK_FALSE(g.erase_edge("a", "b"));
+		CHECK_FALSE(g.is_connected("a", "b"));
+	}
+
+	SECTION("Edges are printed without a weight") {
+		auto out = std::ostringstream{};
+		out << g;
+		CHECK(out.str() == "a (\n  b\n  c\n)\nb (\n)\nc (\n  c\n)\n");
+	}
+}
+
+namespace {
+	// An empty weight type that prints itself, so its edges still carry a weight when printed.
+	struct tag {
+		auto operator<=>(tag const&) const = default;
+	};
+
+	auto operator<<(std::ostream& os, tag const&) -> std::ostream& {
+		return os << "tag";
+	}
+} // namespace
+
+TEST_CASE("Other empty weight types are printed with their weight") {
+	auto g = gdwg::graph<int, tag>{1, 2};
+	CHECK(g.insert_edge(1, 2, tag{}));
+	auto out = std::ostringstream{};
+	out << g;
+	CHECK(out.str() == "1 (\n  2 | tag\n)\n2 (\n)\n");
+}
@@ -0,0 +1,209 @@
+#include "gdwg/matrix_view.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	auto make_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+		g.insert_edge("a", "b", 3);
+		g.insert_edge("a", "b", 1);
+		g.insert_edge("a", "c", 2);
+		g.insert_edge("c", "a", 4);
+		g.insert_edge("c", "c", 5);
+		return g;
+	}
+
+	template<typename G>
+	auto edges_of(G const& g) -> std::vector<std::tuple<int, int, int>> {
+		auto res = std::vector<std::tuple<int, int, int>>{};
+		for (auto const& [from, to, weight] : g) {
+			res.emplace_back(from, to, weight);
+		}
+		return res;
+	}
+
+	template<typename G>
+	auto dump(G const& g) -> std::string {
+		auto os = std::ostringstream{};
+		os << g;
+		return os.str();
+	}
+} // namespace
+
+TEST_CASE("Building a bit matrix from a graph") {
+	auto const& g = make_graph();
+	auto const& view = gdwg::matrix_view<std::string, int>(g);
+
+	SECTION("Accessors match the original graph") {
+		CHECK(view.nodes() == g.nodes());
+		CHECK_FALSE(view.empty());
+		CHECK(view.is_node("d"));
+		CHECK_FALSE(view.is_node("e"));
+
+		CHECK(view.is_connected("a", "b"));
+		CHECK_FALSE(view.is_connected("b", "a"));
+		CHECK(view.weights("a", "b") == std::vector{1, 3});
+		CHECK(view.weights("b", "a").empty());
+		CHECK(view.connections("a") == std::vector<std::string>{"b", "c"});
+		CHECK(view.connections("d").empty());
+		CHECK(view.out_degree("a") == 3);
+		CHECK(view.in_degree("b") == 2);
+		CHECK(view.in_degree("d") == 0);
+	}
+
+	SECTION("Intersections count shared neighbours once") {
+		// a → {b, c} and c → {a, c}
+		CHECK(view.common_connections("a", "c") == 1);
+		CHECK(view.common_connections("a", "a") == 2);
+		CHECK(view.common_connections("a", "d") == 0);
+		// a ← {c} and c ← {a, c}
+		CHECK(view.common_sources("a", "c") == 1);
+		CHECK(view.common_sources("b", "c") == 1);
+	}
+
+	SECTION("Accessors throw on missing nodes") {
+		CHECK_THROWS_WITH(view.is_connected("a", "e"),
+		                  "Cannot call gdwg::matrix_view<N, E>::is_connected if src or dst node "
+		                  "don't exist in the graph");
+		CHECK_THROWS_AS(view.weights("e", "a"), std::runtime_error);
+		CHECK_THROWS_AS(view.connections("e"), std::runtime_error);
+		CHECK_THROWS_AS(view.out_degree("e"), std::runtime_error);
+		CHECK_THROWS_AS(view.in_degree("e"), std::runtime_error);
+		CHECK_THROWS_AS(view.common_connections("a", "e"), std::runtime_error);
+		CHECK_THROWS_AS(view.common_sources("e", "a"), std::runtime_error);
+	}
+
+	SECTION("find() locates edges") {
+		auto const& iter = view.find("a", "b", 3);
+		REQUIRE(iter != view.end());
+		auto const& [from, to, weight] = *iter;
+		CHECK(from == "a");
+		CHECK(to == "b");
+		CHECK(weight == 3);
+		CHECK(std::next(iter) == view.find("a", "c", 2));
+
+		CHECK(view.find("a", "b", 2) == view.end());
+		CHECK(view.find("a", "e", 1) == view.end());
+		CHECK(view.find("d", "a", 1) == view.end());
+	}
+
+	SECTION("Index access exposes rows and columns as words") {
+		auto const a = view.index_of("a");
+		auto const c = view.index_of("c");
+		CHECK(view.index_of("e") == view.npos);
+		CHECK(view.node_count() == 4);
+		CHECK(view.edge_count() == 5);
+		CHECK(view.node_at(c) == "c");
+		CHECK(view.adjacent(c, a));
+		CHECK_FALSE(view.adjacent(a, a));
+		REQUIRE(view.out_bits(a).size() == 1);
+		CHECK(view.out_bits(a)[0] == 0b0110);
+		CHECK(view.in_bits(c)[0] == 0b0101);
+		CHECK(view.out_edge_count(a) == 3);
+		CHECK(view.in_edge_count(a) == 1);
+		CHECK(view.shared_targets(a, c) == 1);
+		CHECK(view.shared_sources(a, c) == 1);
+	}
+
+	SECTION("Output and thawing round trip") {
+		auto os = std::ostringstream{};
+		os << view;
+		auto expected = std::ostringstream{};
+		expected << g;
+		CHECK(os.str() == expected.str());
+		CHECK(view.thaw() == g);
+		CHECK(gdwg::matrix_view<std::string, int>(view.thaw()) == view);
+	}
+}
+
+TEST_CASE("Bit matrices of empty and edgeless graphs") {
+	auto const empty = gdwg::matrix_view<int, int>(gdwg::graph<int, int>{});
+	CHECK(empty.empty());
+	CHECK(empty.begin() == empty.end());
+	CHECK(empty == gdwg::matrix_view<int, int>{});
+	CHECK(dump(empty).empty());
+
+	auto const edgeless = gdwg::matrix_view<int, int>(gdwg::graph<int, int>{3, 1, 2});
+	CHECK(edgeless.begin() == edgeless.end());
+	CHECK(edgeless.connections(2).empty());
+	CHECK(edgeless.common_connections(1, 3) == 0);
+	CHECK(dump(edgeless) == "1 (\n)\n2 (\n)\n3 (\n)\n");
+}
+
+TEST_CASE("Bit matrices refuse graphs with too many nodes") {
+	using view = gdwg::matrix_view<std::size_t, int>;
+	auto nodes = std::vector<std::size_t>(view::max_nodes);
+	std::iota(nodes.begin(), nodes.end(), std::size_t{0});
+	auto g = gdwg::graph<std::size_t, int>(nodes.begin(), nodes.end());
+	CHECK(view(g).node_count() == view::max_nodes);
+
+	g.insert_node(view::max_nodes);
+	CHECK_THROWS_WITH(view(g),
+	                  "Cannot call gdwg::matrix_view<N, E>::matrix_view on a graph with more than "
+	                  "max_nodes nodes");
+}
+
+TEST_CASE("Bit matrices answer exactly like graph") {
+	// spans several words per row, with and without parallel edges
+	auto const parallel = GENERATE(false, true);
+	auto engine = std::mt19937{7};
+	auto value = std::uniform_int_distribution<int>(0, 149);
+	auto g = gdwg::graph<int, int>{};
+	for (auto node = 0; node < 150; node += 1 + node % 3) {
+		g.insert_node(node);
+	}
+	auto const nodes = g.nodes();
+	for (auto step = 0; step < 6000; ++step) {
+		auto const src = value(engine);
+		auto const dst = value(engine);
+		if (g.is_node(src) && g.is_node(dst)) {
+			g.insert_edge(src, dst, parallel ? value(engine) % 3 : 0);
+		}
+	}
+	auto const view = gdwg::matrix_view<int, int>(g);
+
+	CHECK(view.nodes() == nodes);
+	CHECK(view.edge_count() == g.edge_count());
+	CHECK(edges_of(view) == edges_of(g));
+	CHECK(dump(view) == dump(g));
+	CHECK(view.thaw() == g);
+
+	auto backwards = std::vector<std::tuple<int, int, int>>{};
+	for (auto iter = view.end(); iter != view.begin();) {
+		auto const& [from, to, weight] = *--iter;
+		backwards.emplace_back(from, to, weight);
+	}
+	std::reverse(backwards.begin(), backwards.end());
+	CHECK(backwards == edges_of(g));
+
+	for (auto const a : nodes) {
+		REQUIRE(view.connections(a) == g.connections(a));
+		REQUIRE(view.out_degree(a) == g.out_degree(a));
+		REQUIRE(view.in_degree(a) == g.in_degree(a));
+		for (auto const b : nodes) {
+			REQUIRE(view.is_connected(a, b) == g.is_connected(a, b));
+			REQUIRE(view.weights(a, b) == g.weights(a, b));
+
+			auto const a_out = g.connections(a);
+			auto const b_out = g.connections(b);
+			auto common = std::vector<int>{};
+			std::ranges::set_intersection(a_out, b_out, std::back_inserter(common));
+			REQUIRE(view.common_connections(a, b) == common.size());
+		}
+	}
+
+	for (auto const& [from, to, weight] : g) {
+		auto const iter = view.find(from, to, weight);
+		REQUIRE(iter != view.end());
+		REQUIRE((*iter).weight == weight);
+	}
+}